@@ -25,9 +25,26 @@ EMSCRIPTEN_BINDINGS(Structures)
 
     value_object<TextureWrapper>("TextureWrapper")
         .field("frameNr", &TextureWrapper::frameNr)
+        .field("frameSeq", &TextureWrapper::frameSeq)
+        .field("repeated", &TextureWrapper::repeated)
         .field("data", &TextureWrapper::data)
         .field("currLof", &TextureWrapper::currLof)
-        .field("prevLof", &TextureWrapper::prevLof);
+        .field("prevLof", &TextureWrapper::prevLof)
+        .field("dirty", &TextureWrapper::dirty)
+        .field("dirtyBase", &TextureWrapper::dirtyBase)
+        .field("firstDirty", &TextureWrapper::firstDirty)
+        .field("lastDirty", &TextureWrapper::lastDirty)
+        .field("format", &TextureWrapper::format)
+        .field("compact", &TextureWrapper::compact)
+        .field("colors", &TextureWrapper::colors)
+        .field("colorCount", &TextureWrapper::colorCount)
+        .field("scale", &TextureWrapper::scale)
+        .field("reduced", &TextureWrapper::reduced)
+        .field("cropped", &TextureWrapper::cropped)
+        .field("cropX", &TextureWrapper::cropX)
+        .field("cropY", &TextureWrapper::cropY)
+        .field("cropWidth", &TextureWrapper::cropWidth)
+        .field("cropHeight", &TextureWrapper::cropHeight);
 
     value_object<RomInfo>("RomInfo")
         .field("crc32", &RomInfo::crc32)
@@ -302,12 +319,48 @@ TextureWrapper DeniseProxy::getEmulatorTexture()
 {
     TextureWrapper result;
 
-    auto &buffer = amiga->denise.pixelEngine.getStableBuffer();
+    auto &buffer = amiga->denise.pixelEngine.acquireFrame();
 
     result.frameNr = (u32)buffer.nr;
+    result.frameSeq = (u32)buffer.seq;
+    result.repeated = buffer.repeated;
     result.currLof = buffer.lof;
     result.prevLof = buffer.prevlof;
     result.data = (u32)buffer.pixels.ptr;
+    result.dirty = (u32)buffer.dirty;
+    result.dirtyBase = (i32)buffer.dirtyBase;
+    result.firstDirty = (i32)buffer.firstDirty;
+    result.lastDirty = (i32)buffer.lastDirty;
+    result.format = (u32)buffer.format;
+    result.compact = 0;
+    result.colors = 0;
+    result.colorCount = 0;
+    result.scale = (u32)buffer.scale;
+    result.reduced = buffer.scale > 1 ? (u32)buffer.reduced.ptr : 0;
+    result.cropped = buffer.cropWidth ? (u32)buffer.cropped.ptr : 0;
+    result.cropX = (i32)buffer.cropX;
+    result.cropY = (i32)buffer.cropY;
+    result.cropWidth = (i32)buffer.cropWidth;
+    result.cropHeight = (i32)buffer.cropHeight;
+
+    switch (buffer.format) {
+
+        case TEXFMT_RGB565:
+        case TEXFMT_RGBA4444:
+
+            result.compact = (u32)buffer.pixels16.ptr;
+            break;
+
+        case TEXFMT_INDEXED:
+
+            result.compact = (u32)buffer.indices.ptr;
+            result.colors = (u32)buffer.colors.ptr;
+            result.colorCount = (u32)buffer.colorCount;
+            break;
+
+        default:
+            break;
+    }
 
     return result;
 }
@@ -687,6 +740,12 @@ EMSCRIPTEN_BINDINGS(Keys)
     constant("OPT_BRIGHTNESS", (int)OPT_BRIGHTNESS);
     constant("OPT_CONTRAST", (int)OPT_CONTRAST);
     constant("OPT_SATURATION", (int)OPT_SATURATION);
+    constant("OPT_TEXTURE_FORMAT", (int)OPT_TEXTURE_FORMAT);
+    constant("OPT_OUTPUT_RESOLUTION", (int)OPT_OUTPUT_RESOLUTION);
+    constant("OPT_VIEWPORT_CROPPING", (int)OPT_VIEWPORT_CROPPING);
+    constant("OPT_PIPELINING", (int)OPT_PIPELINING);
+    constant("OPT_WARP_FRAME_SKIP", (int)OPT_WARP_FRAME_SKIP);
+    constant("OPT_DIRTY_TRACKING", (int)OPT_DIRTY_TRACKING);
     constant("OPT_DMA_DEBUG_ENABLE", (int)OPT_DMA_DEBUG_ENABLE);
     constant("OPT_DMA_DEBUG_MODE", (int)OPT_DMA_DEBUG_MODE);
     constant("OPT_DMA_DEBUG_OPACITY", (int)OPT_DMA_DEBUG_OPACITY);
@@ -751,6 +810,7 @@ EMSCRIPTEN_BINDINGS(Keys)
     constant("OPT_AUDVOL", (int)OPT_AUDVOL);
     constant("OPT_AUDVOLL", (int)OPT_AUDVOLL);
     constant("OPT_AUDVOLR", (int)OPT_AUDVOLR);
+    constant("OPT_WARP_AUDIO_SKIP", (int)OPT_WARP_AUDIO_SKIP);
     constant("OPT_DIAG_BOARD", (int)OPT_DIAG_BOARD);
     constant("OPT_SRV_PORT", (int)OPT_SRV_PORT);
     constant("OPT_SRV_PROTOCOL", (int)OPT_SRV_PROTOCOL);
@@ -765,6 +825,17 @@ EMSCRIPTEN_BINDINGS(Keys)
     constant("PALETTE_AMBER", (int)PALETTE_AMBER);
     constant("PALETTE_SEPIA", (int)PALETTE_SEPIA);
 
+    // TextureFormat
+    constant("TEXFMT_RGBA8888", (int)TEXFMT_RGBA8888);
+    constant("TEXFMT_RGB565", (int)TEXFMT_RGB565);
+    constant("TEXFMT_RGBA4444", (int)TEXFMT_RGBA4444);
+    constant("TEXFMT_INDEXED", (int)TEXFMT_INDEXED);
+
+    // OutputResolution
+    constant("OUTRES_FULL", (int)OUTRES_FULL);
+    constant("OUTRES_HALF", (int)OUTRES_HALF);
+    constant("OUTRES_QUARTER", (int)OUTRES_QUARTER);
+
     // RamInitPattern
     constant("RAM_INIT_ALL_ZEROES", (int)RAM_INIT_ALL_ZEROES);
     constant("RAM_INIT_ALL_ONES", (int)RAM_INIT_ALL_ONES);
@@ -38,9 +38,26 @@ typedef struct
 typedef struct
 {
     u32 frameNr;
+    u32 frameSeq;
+    bool repeated;
     u32 data;
     bool currLof;
     bool prevLof;
+    u32 dirty;
+    i32 dirtyBase;
+    i32 firstDirty;
+    i32 lastDirty;
+    u32 format;
+    u32 compact;
+    u32 colors;
+    u32 colorCount;
+    u32 scale;
+    u32 reduced;
+    u32 cropped;
+    i32 cropX;
+    i32 cropY;
+    i32 cropWidth;
+    i32 cropHeight;
 } TextureWrapper;
 
 Amiga *amiga = nullptr;
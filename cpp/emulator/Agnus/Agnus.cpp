@@ -232,7 +232,19 @@ Agnus::execute()
 void
 Agnus::execute(DMACycle cycles)
 {
-    for (DMACycle i = 0; i < cycles; i++) execute();
+    while (cycles > 0) {
+
+        // Determine the number of upcoming cycles without pending events
+        auto idle = std::clamp(AS_DMA_CYCLES(nextTrigger - clock - 1), DMACycle(0), cycles);
+
+        // Jump over these cycles
+        clock += DMA_CYCLES(idle);
+        pos.h += idle;
+        cycles -= idle;
+
+        // Execute the next cycle
+        if (cycles) { execute(); cycles--; }
+    }
 }
 
 void
@@ -290,6 +302,9 @@ Agnus::executeUntilBusIsFree()
 
     // Disable overclocking temporarily
     cpu.slowCycles = 1;
+
+    // Revert all Blitter cycles that have been processed in advance
+    blitter.syncFakeBatch();
     
     // Check if the bus is blocked
     if (busOwner[pos.h] != BUS_NONE) {
@@ -301,7 +316,15 @@ Agnus::executeUntilBusIsFree()
         do {
 
             execute();
-            if (++delay == 2) bls = true;
+            if (++delay == 2) { bls = true; blitter.syncFakeBatch(); }
+
+            // Jump over all cycles that are blocked by a fixed DMA slot
+            if (delay >= 2 && busOwner[pos.h] != BUS_NONE) {
+
+                DMACycle skip = nextFreeCycle() - pos.h - 1;
+                execute(skip);
+                delay += skip;
+            }
 
         } while (busOwner[pos.h] != BUS_NONE);
 
@@ -329,8 +352,10 @@ Agnus::executeUntilBusIsFreeForCIA()
 void
 Agnus::recordRegisterChange(Cycle delay, u32 addr, u16 value, Accessor acc)
 {
-    // Record the new register value
-    changeRecorder.insert(clock + delay, RegChange { addr, value, (u16)acc } );
+    // Record the new register value (the counter is for diagnostics only)
+    if (!changeRecorder.insert(clock + delay, RegChange { addr, value, (u16)acc } )) {
+        stats.regChangeOverflows++;
+    }
 
     // Schedule the register change
     scheduleNextREGEvent();
@@ -678,8 +703,11 @@ Agnus::hsyncHandler()
     denise.hsyncHandler(vpos);
     dmaDebugger.hsyncHandler(vpos);
 
-    // Encode a LORES marker in the first HBLANK pixel
-    REPLACE_BIT(*pixelEngine.workingPtr(vpos), 28, res != LORES);
+    // Encode a LORES marker in the first HBLANK pixel (unless the colorizer thread does it)
+    if (!pixelEngine.isQueued(vpos)) REPLACE_BIT(*pixelEngine.workingPtr(vpos), 28, res != LORES);
+
+    // Reduce the resolution of the completed line if requested
+    pixelEngine.reduceLine(vpos);
 
     // Call the vsyncHandler once we've finished a frame
     if (pos.v == 0) vsyncHandler();
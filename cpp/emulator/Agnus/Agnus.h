@@ -77,11 +77,14 @@ public:
     Cycle nextTrigger = NEVER;
     
     // Pending register changes
-    RegChangeRecorder<8> changeRecorder;
+    RegChangeWheel<8, 4> changeRecorder;
 
     // An optional sync event to be processed in serviceRegEvent()
     EventID syncEvent = EVENT_NONE;
 
+    // First DMA cycle of a postponed bitplane event batch (0 = no batch)
+    isize bplBatch = 0;
+
     
     //
     // Counters
@@ -254,6 +257,7 @@ private:
         << nextTrigger
         >> changeRecorder
         << syncEvent
+        << bplBatch
         
         >> pos
         >> latchedPos
@@ -474,6 +478,9 @@ public:
     // Attempts to allocate the bus for the specified resource
     template <BusOwner owner> bool allocateBus();
 
+    // Returns the next DMA cycle in which the bus might be available
+    isize nextFreeCycle() const;
+
     // Performs a DMA read
     u16 doDiskDmaRead();
     template <int channel> u16 doAudioDmaRead();
@@ -760,9 +767,11 @@ public:
 
     // Services a register change event
     void serviceREGEvent(Cycle until);
+    void applyRegisterChange(const RegChange &change);
 
     // Services a bitplane event
     void serviceBPLEvent(EventID id);
+    void processBPLEvent(EventID id);
     template <isize nr> void serviceBPLEventLores();
     template <isize nr> void serviceBPLEventHires();
     template <isize nr> void serviceBPLEventShres();
@@ -778,6 +787,24 @@ public:
     
     // Services an inspection event
     void serviceINSEvent(EventID id);
+
+
+    //
+    // Batching bitplane events (AgnusEvents.cpp)
+    //
+
+public:
+
+    // Postpones the remaining bitplane events of the current line if possible
+    bool batchBplEvents();
+
+    // Processes all postponed bitplane events prior to the given DMA cycle
+    void flushBplBatch(isize end);
+
+    // Processes all postponed bitplane events up to the current DMA cycle
+    void syncBplBatch() {
+        if (bplBatch) { flushBplBatch(pos.h + 1); scheduleNextBplEvent(); }
+    }
 };
 
 }
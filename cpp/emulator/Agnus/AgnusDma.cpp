@@ -81,6 +81,23 @@ Agnus::allocateBus()
     }
 }
 
+isize
+Agnus::nextFreeCycle() const
+{
+    if (pos.h >= HPOS_MAX) return pos.h + 1;
+
+    // Skip all cycles that are blocked by a bitplane fetch or a refresh cycle
+    isize result = sequencer.nextFreeCycle[pos.h + 1];
+
+    // Don't look beyond the next register change or Copper access
+    Cycle limit = std::min(trigger[SLOT_REG], trigger[SLOT_COP]);
+    if (clock + DMA_CYCLES(result - pos.h) > limit) {
+        result = pos.h + std::max(Cycle(1), AS_DMA_CYCLES(limit - clock));
+    }
+
+    return result;
+}
+
 u16
 Agnus::doDiskDmaRead()
 {
@@ -171,6 +188,7 @@ Agnus::doBlitterDmaRead(u32 addr)
 void
 Agnus::doDiskDmaWrite(u16 value)
 {
+    syncBplBatch();
     mem.poke16 <ACCESSOR_AGNUS> (dskpt, value);
     dskpt += 2;
 
@@ -201,6 +201,13 @@ Agnus::serviceREGEvent(Cycle until)
     assert(pos.type != PAL || pos.h <= HPOS_CNT_PAL);
     assert(pos.type == PAL || pos.h <= HPOS_CNT_NTSC);
 
+    // Process all postponed bitplane events before anything else happens
+    if (bplBatch) {
+
+        flushBplBatch(pos.h);
+        scheduleBplEventForCycle(pos.h);
+    }
+
     if (syncEvent) {
 
         // Call the EOL handler if requested
@@ -218,87 +225,102 @@ Agnus::serviceREGEvent(Cycle until)
         // We're done once the trigger cycle exceeds the target cycle
         if (changeRecorder.trigger() > until) break;
 
-        // Apply the register change
-        RegChange &change = changeRecorder.read();
-
-        switch (change.addr) {
-
-            case SET_BLTSIZE: blitter.setBLTSIZE(change.value); break;
-            case SET_BLTSIZV: blitter.setBLTSIZV(change.value); break;
-                
-            case SET_BLTCON0: blitter.setBLTCON0(change.value); break;
-            case SET_BLTCON0L: blitter.setBLTCON0L(change.value); break;
-            case SET_BLTCON1: blitter.setBLTCON1(change.value); break;
-                
-            case SET_INTREQ: paula.setINTREQ(change.value); break;
-            case SET_INTENA: paula.setINTENA(change.value); break;
-                
-            case SET_BPLCON0_AGNUS: setBPLCON0(bplcon0, change.value); break;
-            case SET_BPLCON0_DENISE: denise.setBPLCON0(bplcon0, change.value); break;
-            case SET_BPLCON1_AGNUS: setBPLCON1(bplcon1, change.value); break;
-            case SET_BPLCON1_DENISE: denise.setBPLCON1(bplcon1, change.value); break;
-            case SET_BPLCON2: denise.setBPLCON2(change.value); break;
-            case SET_BPLCON3: denise.setBPLCON3(change.value); break;
-                
-            case SET_DMACON: setDMACON(dmacon, change.value); break;
-                
-            case SET_DIWSTRT_AGNUS: sequencer.setDIWSTRT(change.value); break;
-            case SET_DIWSTRT_DENISE: denise.setDIWSTRT(change.value); break;
-            case SET_DIWSTOP_AGNUS: sequencer.setDIWSTOP(change.value); break;
-            case SET_DIWSTOP_DENISE: denise.setDIWSTOP(change.value); break;
-            case SET_DIWHIGH_AGNUS: sequencer.setDIWHIGH(change.value); break;
-            case SET_DIWHIGH_DENISE: denise.setDIWHIGH(change.value); break;
-
-            case SET_DDFSTRT: sequencer.setDDFSTRT(change.value); break;
-            case SET_DDFSTOP: sequencer.setDDFSTOP(change.value); break;
-                
-            case SET_BPL1MOD: setBPL1MOD(change.value); break;
-            case SET_BPL2MOD: setBPL2MOD(change.value); break;
-                
-            case SET_BPL1PTH: setBPLxPTH<1>(change.value); break;
-            case SET_BPL2PTH: setBPLxPTH<2>(change.value); break;
-            case SET_BPL3PTH: setBPLxPTH<3>(change.value); break;
-            case SET_BPL4PTH: setBPLxPTH<4>(change.value); break;
-            case SET_BPL5PTH: setBPLxPTH<5>(change.value); break;
-            case SET_BPL6PTH: setBPLxPTH<6>(change.value); break;
-
-            case SET_BPL1PTL: setBPLxPTL<1>(change.value); break;
-            case SET_BPL2PTL: setBPLxPTL<2>(change.value); break;
-            case SET_BPL3PTL: setBPLxPTL<3>(change.value); break;
-            case SET_BPL4PTL: setBPLxPTL<4>(change.value); break;
-            case SET_BPL5PTL: setBPLxPTL<5>(change.value); break;
-            case SET_BPL6PTL: setBPLxPTL<6>(change.value); break;
-
-            case SET_SPR0PTH: setSPRxPTH<0>(change.value); break;
-            case SET_SPR1PTH: setSPRxPTH<1>(change.value); break;
-            case SET_SPR2PTH: setSPRxPTH<2>(change.value); break;
-            case SET_SPR3PTH: setSPRxPTH<3>(change.value); break;
-            case SET_SPR4PTH: setSPRxPTH<4>(change.value); break;
-            case SET_SPR5PTH: setSPRxPTH<5>(change.value); break;
-            case SET_SPR6PTH: setSPRxPTH<6>(change.value); break;
-            case SET_SPR7PTH: setSPRxPTH<7>(change.value); break;
-
-            case SET_SPR0PTL: setSPRxPTL<0>(change.value); break;
-            case SET_SPR1PTL: setSPRxPTL<1>(change.value); break;
-            case SET_SPR2PTL: setSPRxPTL<2>(change.value); break;
-            case SET_SPR3PTL: setSPRxPTL<3>(change.value); break;
-            case SET_SPR4PTL: setSPRxPTL<4>(change.value); break;
-            case SET_SPR5PTL: setSPRxPTL<5>(change.value); break;
-            case SET_SPR6PTL: setSPRxPTL<6>(change.value); break;
-            case SET_SPR7PTL: setSPRxPTL<7>(change.value); break;
-
-            case SET_DSKPTH: setDSKPTH(change.value); break;
-            case SET_DSKPTL: setDSKPTL(change.value); break;
-
-            case SET_SERDAT: uart.setSERDAT(change.value); break;
-
-            default:
-                fatalError;
-        }
+        // Fetch all register changes that are due in this cycle
+        RegChange batch[8];
+        isize count = changeRecorder.readBatch(batch, 8);
+
+        // Apply the register changes
+        for (isize i = 0; i < count; i++) applyRegisterChange(batch[i]);
     }
 
-    // Schedule next event
-    scheduleNextREGEvent();
+    /* Schedule next event. Unlike scheduleNextREGEvent(), which only ever
+     * moves the trigger cycle closer, the trigger is set unconditionally here.
+     * Otherwise, the slot would fire in every cycle once the recorder is drained.
+     */
+    if (changeRecorder.isEmpty()) {
+        cancel<SLOT_REG>();
+    } else {
+        scheduleAbs<SLOT_REG>(changeRecorder.trigger(), REG_CHANGE);
+    }
+}
+
+void
+Agnus::applyRegisterChange(const RegChange &change)
+{
+    switch (change.addr) {
+
+        case SET_BLTSIZE: blitter.setBLTSIZE(change.value); break;
+        case SET_BLTSIZV: blitter.setBLTSIZV(change.value); break;
+            
+        case SET_BLTCON0: blitter.setBLTCON0(change.value); break;
+        case SET_BLTCON0L: blitter.setBLTCON0L(change.value); break;
+        case SET_BLTCON1: blitter.setBLTCON1(change.value); break;
+            
+        case SET_INTREQ: paula.setINTREQ(change.value); break;
+        case SET_INTENA: paula.setINTENA(change.value); break;
+            
+        case SET_BPLCON0_AGNUS: setBPLCON0(bplcon0, change.value); break;
+        case SET_BPLCON0_DENISE: denise.setBPLCON0(bplcon0, change.value); break;
+        case SET_BPLCON1_AGNUS: setBPLCON1(bplcon1, change.value); break;
+        case SET_BPLCON1_DENISE: denise.setBPLCON1(bplcon1, change.value); break;
+        case SET_BPLCON2: denise.setBPLCON2(change.value); break;
+        case SET_BPLCON3: denise.setBPLCON3(change.value); break;
+            
+        case SET_DMACON: setDMACON(dmacon, change.value); break;
+            
+        case SET_DIWSTRT_AGNUS: sequencer.setDIWSTRT(change.value); break;
+        case SET_DIWSTRT_DENISE: denise.setDIWSTRT(change.value); break;
+        case SET_DIWSTOP_AGNUS: sequencer.setDIWSTOP(change.value); break;
+        case SET_DIWSTOP_DENISE: denise.setDIWSTOP(change.value); break;
+        case SET_DIWHIGH_AGNUS: sequencer.setDIWHIGH(change.value); break;
+        case SET_DIWHIGH_DENISE: denise.setDIWHIGH(change.value); break;
+
+        case SET_DDFSTRT: sequencer.setDDFSTRT(change.value); break;
+        case SET_DDFSTOP: sequencer.setDDFSTOP(change.value); break;
+            
+        case SET_BPL1MOD: setBPL1MOD(change.value); break;
+        case SET_BPL2MOD: setBPL2MOD(change.value); break;
+            
+        case SET_BPL1PTH: setBPLxPTH<1>(change.value); break;
+        case SET_BPL2PTH: setBPLxPTH<2>(change.value); break;
+        case SET_BPL3PTH: setBPLxPTH<3>(change.value); break;
+        case SET_BPL4PTH: setBPLxPTH<4>(change.value); break;
+        case SET_BPL5PTH: setBPLxPTH<5>(change.value); break;
+        case SET_BPL6PTH: setBPLxPTH<6>(change.value); break;
+
+        case SET_BPL1PTL: setBPLxPTL<1>(change.value); break;
+        case SET_BPL2PTL: setBPLxPTL<2>(change.value); break;
+        case SET_BPL3PTL: setBPLxPTL<3>(change.value); break;
+        case SET_BPL4PTL: setBPLxPTL<4>(change.value); break;
+        case SET_BPL5PTL: setBPLxPTL<5>(change.value); break;
+        case SET_BPL6PTL: setBPLxPTL<6>(change.value); break;
+
+        case SET_SPR0PTH: setSPRxPTH<0>(change.value); break;
+        case SET_SPR1PTH: setSPRxPTH<1>(change.value); break;
+        case SET_SPR2PTH: setSPRxPTH<2>(change.value); break;
+        case SET_SPR3PTH: setSPRxPTH<3>(change.value); break;
+        case SET_SPR4PTH: setSPRxPTH<4>(change.value); break;
+        case SET_SPR5PTH: setSPRxPTH<5>(change.value); break;
+        case SET_SPR6PTH: setSPRxPTH<6>(change.value); break;
+        case SET_SPR7PTH: setSPRxPTH<7>(change.value); break;
+
+        case SET_SPR0PTL: setSPRxPTL<0>(change.value); break;
+        case SET_SPR1PTL: setSPRxPTL<1>(change.value); break;
+        case SET_SPR2PTL: setSPRxPTL<2>(change.value); break;
+        case SET_SPR3PTL: setSPRxPTL<3>(change.value); break;
+        case SET_SPR4PTL: setSPRxPTL<4>(change.value); break;
+        case SET_SPR5PTL: setSPRxPTL<5>(change.value); break;
+        case SET_SPR6PTL: setSPRxPTL<6>(change.value); break;
+        case SET_SPR7PTL: setSPRxPTL<7>(change.value); break;
+
+        case SET_DSKPTH: setDSKPTH(change.value); break;
+        case SET_DSKPTL: setDSKPTL(change.value); break;
+
+        case SET_SERDAT: uart.setSERDAT(change.value); break;
+
+        default:
+            fatalError;
+    }
 }
 
 #define LO_NONE(x)      { serviceBPLEventLores<x>(); }
@@ -333,6 +355,19 @@ Agnus::serviceREGEvent(Cycle until)
 
 void
 Agnus::serviceBPLEvent(EventID id)
+{
+    // Process all postponed events if this is the last event of a batch
+    if (bplBatch) flushBplBatch(pos.h);
+
+    // Process the current event
+    processBPLEvent(id);
+
+    // Schedule next event
+    if (!batchBplEvents()) scheduleNextBplEvent();
+}
+
+void
+Agnus::processBPLEvent(EventID id)
 {
     switch (id) {
 
@@ -477,9 +512,6 @@ Agnus::serviceBPLEvent(EventID id)
             dump(Category::Dma);
             fatalError;
     }
-
-    // Schedule next event
-    scheduleNextBplEvent();
 }
 
 template <isize nr> void
@@ -503,6 +535,71 @@ Agnus::serviceBPLEventShres()
     denise.setBPLxDAT<nr>(doBitplaneDmaRead<nr>());
 }
 
+bool
+Agnus::batchBplEvents()
+{
+    if constexpr (NO_BPL_BATCHING) return false;
+
+    // Only batch once per line, starting at the first bitplane event
+    if (sequencer.nextBplEvent[0] != pos.h) return false;
+
+    // Determine the first and the last remaining event in this line
+    isize first = sequencer.nextBplEvent[pos.h];
+    isize last = first;
+    while (sequencer.nextBplEvent[last] != HPOS_MAX) last = sequencer.nextBplEvent[last];
+
+    // Only proceed if there is something to batch
+    if (first >= last) return false;
+
+    /* Only proceed if nothing is going to interfere. Register changes, Copper
+     * writes, and the HSYNC handler would cancel the batch anyway. A running
+     * Blitter might modify bitplane data before it is fetched.
+     */
+    Cycle end = clock + DMA_CYCLES(last - pos.h);
+    if (trigger[SLOT_REG] <= end) return false;
+    if (trigger[SLOT_COP] <= end) return false;
+    if (blitter.isActive()) return false;
+
+    // Reserve the bus for all postponed bitplane DMA cycles
+    for (isize i = first; i < last; i = sequencer.nextBplEvent[i]) {
+
+        auto nr = bplEventNr(sequencer.bplEvent[i]);
+        if (nr >= 0) busOwner[i] = BusOwner(BUS_BPL1 + nr);
+    }
+
+    // Postpone all events up to the last one
+    bplBatch = first;
+    scheduleRel<SLOT_BPL>(DMA_CYCLES(last - pos.h), sequencer.bplEvent[last]);
+
+    return true;
+}
+
+void
+Agnus::flushBplBatch(isize end)
+{
+    assert(bplBatch);
+    assert(end <= HPOS_MAX);
+
+    auto posh = pos.h;
+    isize i = bplBatch;
+
+    // Process all postponed events in the order they would have been serviced
+    for (; i < end; i = sequencer.nextBplEvent[i]) {
+
+        pos.h = i;
+        processBPLEvent(sequencer.bplEvent[i]);
+    }
+
+    // Release the bus for all reserved cycles that haven't been reached yet
+    for (; sequencer.nextBplEvent[i] != HPOS_MAX; i = sequencer.nextBplEvent[i]) {
+
+        if (bplEventNr(sequencer.bplEvent[i]) >= 0) busOwner[i] = BUS_NONE;
+    }
+
+    pos.h = posh;
+    bplBatch = 0;
+}
+
 void
 Agnus::serviceVBLEvent(EventID id)
 {
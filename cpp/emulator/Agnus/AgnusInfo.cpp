@@ -480,6 +480,8 @@ Agnus::_dump(Category category, std::ostream& os) const
         os << dec(scrollEven) << std::endl;
         os << tab("BLS signal");
         os << bol(bls) << std::endl;
+        os << tab("Reg change overflows");
+        os << dec(stats.regChangeOverflows) << std::endl;
         
         sequencer.dump(Category::Debug, os);
     }
@@ -415,6 +415,24 @@ static inline bool isBplxEvent(EventID id, int x)
     }
 }
 
+static inline int bplEventNr(EventID id)
+{
+    switch(id & ~0b11) {
+
+        case BPL_L1: case BPL_L1_MOD: case BPL_H1: case BPL_H1_MOD: return 0;
+        case BPL_L2: case BPL_L2_MOD: case BPL_H2: case BPL_H2_MOD: return 1;
+        case BPL_L3: case BPL_L3_MOD: case BPL_H3: case BPL_H3_MOD: return 2;
+        case BPL_L4: case BPL_L4_MOD: case BPL_H4: case BPL_H4_MOD: return 3;
+        case BPL_L5: case BPL_L5_MOD:                               return 4;
+        case BPL_L6: case BPL_L6_MOD:                               return 5;
+        case BPL_S1: case BPL_S1_MOD:                               return 0;
+        case BPL_S2: case BPL_S2_MOD:                               return 1;
+
+        default:
+            return -1;
+    }
+}
+
 enum_long(SPR_DMA_STATE)
 {
     SPR_DMA_IDLE,
@@ -522,7 +540,10 @@ EventInfo;
 typedef struct
 {
     isize usage[BUS_COUNT];
-    
+
+    // Number of register changes that went into the backup buffer of the wheel
+    isize regChangeOverflows;
+
     double copperActivity;
     double blitterActivity;
     double diskActivity;
@@ -59,7 +59,17 @@ Blitter::_reset(bool hard)
         blitcount = 1;
         copycount = 0;
         linecount = 0;
+        conflicts = 0;
     }
+
+    undoable = false;
+}
+
+void
+Blitter::_didLoad()
+{
+    // The undo log doesn't belong to the loaded blit
+    undoable = false;
 }
 
 void
@@ -107,8 +117,8 @@ Blitter::setConfigItem(Option option, i64 value)
             
         case OPT_BLITTER_ACCURACY:
         {
-            if (value < 0 || value > 2) {
-                throw VAError(ERROR_OPT_INVARG, "0, 1, 2");
+            if (value < 0 || value > 3) {
+                throw VAError(ERROR_OPT_INVARG, "0, 1, 2, 3");
             }
             
             SUSPENDED
@@ -499,12 +509,15 @@ Blitter::prepareBlit()
 
     bltpc = 0;
     iteration = 0;
+    programMask = 0;
 }
 
 void
 Blitter::beginBlit()
 {
-    auto level = config.accuracy;
+    auto level = config.accuracy == 3 ? adaptiveLevel() : config.accuracy;
+
+    if (tracing) recordBlitStart(level);
 
     if (bltconLINE()) {
 
@@ -609,7 +622,11 @@ Blitter::endBlit()
     debug(BLTTIM_DEBUG, "(%ld,%ld) Blitter terminates\n", agnus.pos.v, agnus.pos.h);
     
     running = false;
+    guardLen = 0;
+    undoable = false;
     if constexpr (BLT_MEM_GUARD) blitcount++;
+
+    if (tracing) recordBlitEnd();
     
     // Clear the Blitter slot
     agnus.cancel<SLOT_BLT>();
@@ -625,4 +642,214 @@ Blitter::endBlit()
     copper.blitterDidTerminate();
 }
 
+isize
+Blitter::adaptiveLevel()
+{
+    // Keep an eye on the CPU and the Copper while the blit is in flight
+    guardBlit();
+
+    return agnus.pos.frame < exactUntil ? 2 : 1;
+}
+
+void
+Blitter::guardBlit()
+{
+    i64 lo = INT64_MAX;
+    i64 hi = INT64_MIN;
+
+    auto add = [&](u32 ptr, i64 from, i64 to) {
+
+        lo = std::min(lo, i64(ptr & agnus.ptrMask) + from);
+        hi = std::max(hi, i64(ptr & agnus.ptrMask) + to);
+    };
+
+    if (bltconLINE()) {
+
+        // A line can advance by at most one row and one word per step
+        i64 delta = i64(bltsizeV) * (std::abs(bltcmod) + 2);
+
+        add(bltcpt, -delta, delta + 2);
+        add(bltdpt, -delta, delta + 2);
+
+    } else {
+
+        i64 width = 2 * i64(bltsizeH);
+        bool desc = bltconDESC();
+
+        auto channel = [&](bool use, u32 ptr, i16 mod) {
+
+            if (!use) return;
+
+            i64 last = (i64(bltsizeV) - 1) * (width + mod);
+            if (desc) {
+                add(ptr, std::min(-last, i64(0)) - width + 2, std::max(-last, i64(0)) + 2);
+            } else {
+                add(ptr, std::min(last, i64(0)), std::max(last, i64(0)) + width);
+            }
+        };
+
+        channel(bltconUSEA(), bltapt, bltamod);
+        channel(bltconUSEB(), bltbpt, bltbmod);
+        channel(bltconUSEC(), bltcpt, bltcmod);
+        channel(bltconUSED(), bltdpt, bltdmod);
+    }
+
+    if (lo > hi) {
+
+        // The blit doesn't touch memory
+        guardStart = 0;
+        guardLen = 0;
+
+    } else if (lo < 0 || hi > mem.chipRamSize()) {
+
+        // The blit wraps around or leaves Chip RAM
+        guardStart = 0;
+        guardLen = u32(mem.chipRamSize());
+
+    } else {
+
+        guardStart = u32(lo);
+        guardLen = u32(hi - lo);
+    }
+}
+
+void
+Blitter::signalConflict()
+{
+    // Number of conflict-free frames before returning to the Fast Blitter
+    constexpr i64 cooldown = 50;
+
+    trace(BLT_DEBUG, "(%ld,%ld) Conflict with running blit\n", agnus.pos.v, agnus.pos.h);
+
+    conflicts++;
+    guardLen = 0;
+    exactUntil = agnus.pos.frame + cooldown;
+
+    // The Fast Blitter's results are wrong now if the blit is a level 1 blit
+    if (undoable) finishAccurately();
+}
+
+void
+Blitter::prepareUndo()
+{
+    undoable = guardLen != 0;
+    if (!undoable) return;
+
+    undoRegs = {
+
+        .bltcon0 = bltcon0,
+        .bltcon1 = bltcon1,
+        .bltapt = bltapt,
+        .bltbpt = bltbpt,
+        .bltcpt = bltcpt,
+        .bltdpt = bltdpt,
+        .bltadat = anew,
+        .bltbdat = bnew,
+        .bltcdat = chold
+    };
+    undoLog.clear();
+
+    // In copy mode, the words written by channel D are known in advance
+    if (!bltconLINE() && bltconUSED()) {
+
+        bool desc = bltconDESC();
+        i32 incr = desc ? -2 : 2;
+        i32 dmod = desc ? -bltdmod : bltdmod;
+        u32 dpt = bltdpt;
+
+        for (isize y = 0; y < bltsizeV; y++) {
+
+            for (isize x = 0; x < bltsizeH; x++) {
+
+                recordUndo(dpt);
+                dpt = U32_ADD(dpt, incr);
+            }
+            dpt = U32_ADD(dpt, dmod);
+        }
+    }
+}
+
+void
+Blitter::recordUndo(u32 addr)
+{
+    undoLog.push_back({ addr, mem.spypeek16 <ACCESSOR_AGNUS> (addr) });
+}
+
+void
+Blitter::finishAccurately()
+{
+    /* When the conflict is detected, the fake micro-program has advanced to
+     * the current cycle. The Slow Blitter runs the same micro-program with the
+     * same step structure. Hence, we revert the Fast Blitter and let the Slow
+     * Blitter catch up with the fake program in one go. From then on, the
+     * remaining cycles are performed by the Slow Blitter.
+     */
+    assert(agnus.hasEvent<SLOT_BLT>(BLT_COPY_FAKE) || agnus.hasEvent<SLOT_BLT>(BLT_LINE_FAKE));
+
+    trace(BLT_DEBUG, "Finishing blit with the Slow Blitter\n");
+
+    // Revert all cycles that have been processed in advance
+    syncFakeBatch();
+    undoable = false;
+
+    // Remember where the fake micro-program stands
+    auto pc = bltpc;
+    auto iter = iteration;
+    auto trigger = agnus.trigger[SLOT_BLT];
+    auto skip = skipping;
+    auto dataBus = mem.dataBus;
+
+    // Undo all Chip RAM writes of the Fast Blitter
+    for (auto it = undoLog.rbegin(); it != undoLog.rend(); it++) {
+        mem.poke16 <ACCESSOR_AGNUS> (it->first, it->second);
+    }
+
+    // Restore the registers the Fast Blitter has modified
+    bltcon0 = undoRegs.bltcon0;
+    bltcon1 = undoRegs.bltcon1;
+    bltapt = undoRegs.bltapt;
+    bltbpt = undoRegs.bltbpt;
+    bltcpt = undoRegs.bltcpt;
+    bltdpt = undoRegs.bltdpt;
+    anew = undoRegs.bltadat;
+    bnew = undoRegs.bltbdat;
+    chold = undoRegs.bltcdat;
+
+    prepareBlit();
+
+    // Make sure the Slow Blitter is granted the bus in every cycle
+    auto dmacon = agnus.dmacon;
+    auto bls = agnus.getBLS();
+    auto owner = agnus.busOwner[agnus.pos.h];
+    auto value = agnus.busValue[agnus.pos.h];
+    agnus.dmacon |= DMAEN | BLTEN;
+    agnus.setBLS(false);
+
+    if (bltconLINE()) {
+        beginSlowLineBlit();
+    } else {
+        beginSlowCopyBlit();
+    }
+
+    // Catch up with the fake micro-program
+    while (agnus.hasEvent<SLOT_BLT>() && (iteration != iter || bltpc != pc)) {
+
+        agnus.busOwner[agnus.pos.h] = BUS_NONE;
+        serviceEvent();
+    }
+
+    agnus.busOwner[agnus.pos.h] = owner;
+    agnus.busValue[agnus.pos.h] = value;
+    agnus.dmacon = dmacon;
+    agnus.setBLS(bls);
+    mem.dataBus = dataBus;
+
+    // Continue in the cycle the fake micro-program would have continued in
+    if (agnus.hasEvent<SLOT_BLT>()) {
+
+        agnus.scheduleAbs<SLOT_BLT>(trigger, bltconLINE() ? BLT_LINE_SLOW : BLT_COPY_SLOW);
+        skipping = skip;
+    }
+}
+
 }
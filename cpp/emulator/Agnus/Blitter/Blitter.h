@@ -13,6 +13,7 @@
 #include "Memory.h"
 #include "AgnusTypes.h"
 #include "SubComponent.h"
+#include "IOUtils.h"
 
 namespace vamiga {
 
@@ -27,6 +28,10 @@ namespace vamiga {
  * Level 2: Moves data word by word like the real Blitter does.
  *          Uses up bus cycles like the real Blitter does.
  *
+ * Level 3: Adaptive mode. Runs blits with level 1 accuracy unless the CPU or
+ *          the Copper has recently interfered with a running blit. In that
+ *          case, blits are run with level 2 accuracy for a while.
+ *
  * Level 0 and 1 invoke the FastBlitter. Level 2 invokes the SlowBlitter.
  */
 
@@ -90,8 +95,14 @@ class Blitter : public SubComponent
     // Fast Blitter
     //
     
-    // The Fast Blitter's blit functions
-    void (Blitter::*blitfunc[32])(void);
+    // The Fast Blitter's blit functions [fill][minterm class][channels, desc]
+    void (Blitter::*blitfunc[2][5][32])(void);
+
+    // Scratch buffers used for processing a line of a copy blit at once
+    u16 rowA[0x801];
+    u16 rowB[0x801];
+    u16 rowC[0x800];
+    u16 rowD[0x800];
     
     
     //
@@ -128,6 +139,22 @@ class Blitter : public SubComponent
     
     // If true, the D register won't be written to memory
     bool lockD;
+
+    // Indicates if the Blitter jumps over cycles blocked by fixed DMA slots
+    bool skipping;
+
+    // Micro-instructions of the running fake program, recorded on execution
+    u16 program[8];
+    u8 programMask;
+
+    // Cycle and state at the beginning of a batch of fake cycles
+    Cycle batchStart;
+    isize batchCycles;
+    u16 batchPc;
+    u16 batchX;
+    u16 batchY;
+    isize batchIteration;
+    bool batchLockD;
     
     
     //
@@ -152,6 +179,37 @@ class Blitter : public SubComponent
     bool birq;
     
     
+    //
+    // Adaptive accuracy
+    //
+    
+    /* In adaptive mode, the Chip RAM range accessed by the running blit is
+     * guarded. A conflict is signaled if the CPU accesses this range or if a
+     * Blitter register is written while the blit is in flight. At that point,
+     * the Fast Blitter has already written all data. Hence, the overwritten
+     * Chip RAM words are recorded when a level 1 blit starts. On a conflict,
+     * they are restored and the blit is finished by the Slow Blitter. After
+     * that, all blits are run with the Slow Blitter until no more conflicts
+     * have been detected for a certain number of frames.
+     */
+    
+    // The guarded Chip RAM range (no range is guarded if guardLen is zero)
+    u32 guardStart;
+    u32 guardLen;
+    
+    // Frame number until which blits are run with the Slow Blitter
+    i64 exactUntil;
+
+    // Indicates if the running level 1 blit can be finished accurately
+    bool undoable = false;
+
+    // Register values at the beginning of the running level 1 blit
+    BlitTraceItem undoRegs;
+
+    // Chip RAM words overwritten by the Fast Blitter (address, old value)
+    std::vector<std::pair<u32, u16>> undoLog;
+    
+    
     //
     // Counters
     //
@@ -165,6 +223,7 @@ private:
     isize blitcount;
     isize copycount;
     isize linecount;
+    isize conflicts;
     
     // Debug checksums
     u32 check1;
@@ -174,6 +233,23 @@ public:
     
     // Optional storage for recording memory locations if BLT_GUARD is enabled
     Buffer<isize> memguard;
+
+
+    //
+    // Tracing
+    //
+
+private:
+
+    // Indicates if blits are recorded
+    bool tracing = false;
+
+    // Recorded blits (recording stops when the capacity is reached)
+    static constexpr isize traceCapacity = 100000;
+    std::vector<BlitTraceItem> traceItems;
+
+    // Chip RAM image taken when the recording was started
+    std::vector<u8> traceRam;
     
     
     //
@@ -208,6 +284,7 @@ private:
     
     void _initialize() override;
     void _reset(bool hard) override;
+    void _didLoad() override;
     void _run() override;
     void _inspect() const override;
     
@@ -267,12 +344,27 @@ private:
         << fillCarry
         << mask
         << lockD
+        << skipping
+        
+        << program
+        << programMask
+        << batchStart
+        << batchCycles
+        << batchPc
+        << batchX
+        << batchY
+        << batchIteration
+        << batchLockD
         
         << running
         << bbusy
         << bzero
         << birq
         
+        << guardStart
+        << guardLen
+        << exactUntil
+        
         << remaining;
     }
     
@@ -386,6 +478,36 @@ public:
     void pokeBLTCDAT(u16 value);
     
     
+    //
+    // Tracing blits (BlitterTrace.cpp)
+    //
+
+public:
+
+    // Starts or stops recording blits
+    void startTrace();
+    void stopTrace();
+    bool isTracing() const { return tracing; }
+
+    // Writes the recorded blits together with the Chip RAM image into a file
+    void saveTrace(const fs::path &path) const;
+
+    // Runs the recorded blits again and reports the result
+    void replayTrace(std::ostream &os);
+
+private:
+
+    /* Runs all recorded blits with the specified accuracy level. If a blit
+     * does not terminate, the replay is aborted and the number of the blit is
+     * written into 'stalled' (-1 otherwise).
+     */
+    u32 replayBlits(isize level, isize &stalled);
+
+    // Called at the beginning and at the end of each blit
+    void recordBlitStart(isize level);
+    void recordBlitEnd();
+
+
     //
     // Handling requests of other components
     //
@@ -395,6 +517,15 @@ public:
     // Called by Agnus when DMACON is written to
     void pokeDMACON(u16 oldValue, u16 newValue);
     
+    // Called by the memory when the CPU accesses Chip RAM
+    void checkMemAccess(u32 addr) { if (addr - guardStart < guardLen) signalConflict(); }
+    
+    // Called when a Blitter register is written while the Blitter is running
+    void checkRegAccess() { if (guardLen) signalConflict(); }
+
+    // Called by Agnus before the CPU accesses the bus
+    void syncFakeBatch() { if (batchCycles) rollbackFakeBatch(); }
+    
     
     //
     // Serving events
@@ -405,6 +536,9 @@ public:
     // Processes a Blitter event
     void serviceEvent();
     void serviceEvent(EventID id);
+
+    // Called by the Sequencer when the bitplane event table has changed
+    void bplEventTableDidChange();
     
     
     //
@@ -419,6 +553,7 @@ private:
     // Emulates the minterm logic circuit
     u16 doMintermLogic     (u16 a, u16 b, u16 c, u8 minterm) const;
     u16 doMintermLogicQuick(u16 a, u16 b, u16 c, u8 minterm) const;
+    template <u16 minterm> u16 doMintermLogic(u16 a, u16 b, u16 c) const;
     
     // Emulates the fill logic circuit
     void doFill(u16 &data, bool &carry) const;
@@ -448,6 +583,31 @@ private:
     void endBlit();
     
     
+    //
+    // Adapting the accuracy level
+    //
+    
+private:
+    
+    // Selects the accuracy level for the next blit in adaptive mode
+    isize adaptiveLevel();
+    
+    // Guards the Chip RAM range touched by the current blit
+    void guardBlit();
+    
+    // Called when the CPU or the Copper interferes with a running blit
+    void signalConflict();
+
+    // Records the data needed to finish a level 1 blit with the Slow Blitter
+    void prepareUndo();
+
+    // Records a Chip RAM word before the Fast Blitter overwrites it
+    void recordUndo(u32 addr);
+
+    // Reverts the Fast Blitter and finishes the blit with the Slow Blitter
+    void finishAccurately();
+    
+    
     //
     //  Executing the Fast Blitter
     //
@@ -459,8 +619,17 @@ private:
     void beginFastLineBlit();
     
     // Performs a copy blit operation via the FastBlitter
-    template <bool useA, bool useB, bool useC, bool useD, bool desc>
+    void runFastCopyBlit();
+    template <bool useA, bool useB, bool useC, bool useD, bool desc, bool fill, u16 minterm>
     void doFastCopyBlit();
+
+    // Performs a single line of a copy blit on a host memory pointer
+    template <bool useA, bool useB, bool useC, bool useD, bool desc, bool fill, u16 minterm>
+    void doFastCopyRow(const u8 *a, const u8 *b, const u8 *c, u8 *d, u32 dpt, bool &carry);
+
+    // Returns a host pointer to a line of blit data or nullptr if the line
+    // is not fully contained in Chip RAM
+    u8 *chipRamRow(u32 addr, bool desc) const;
     
     // Performs a line blit operation via the FastBlitter
     void doFastLineBlit();
@@ -490,6 +659,18 @@ private:
     // Emulates a Blitter micro-instruction (line mode)
     template <u16 instr> void execLine();
     template <u16 instr> void fakeExecLine();
+
+    // Postpones the next micro-instruction to the next cycle the bus might be free
+    void skipBlockedCycles();
+
+    // Processes the upcoming cycles of a fake blit in one go if possible
+    template <bool line> void batchFakeCycles();
+
+    // Performs a single fake micro-instruction in a batch
+    template <bool line> bool advanceFakeProgram(isize h, bool replay = false);
+
+    // Reverts all batched cycles that haven't been reached yet
+    void rollbackFakeBatch();
     
     // Checks iterations
     bool isFirstWord() const { return xCounter == bltsizeH; }
@@ -22,6 +22,9 @@ Blitter::serviceEvent()
 void
 Blitter::serviceEvent(EventID id)
 {
+    skipping = false;
+    batchCycles = 0;
+
     switch (id) {
 
         case BLT_STRT1:
@@ -86,4 +89,15 @@ Blitter::serviceEvent(EventID id)
     }
 }
 
+void
+Blitter::bplEventTableDidChange()
+{
+    // Revisit all skipped cycles, as some of them might be free now
+    if (skipping && agnus.trigger[SLOT_BLT] > agnus.clock) {
+
+        agnus.rescheduleAbs<SLOT_BLT>(agnus.clock);
+    }
+    skipping = false;
+}
+
 }
@@ -78,6 +78,10 @@ Blitter::_dump(Category category, std::ostream& os) const
         os << tab("SHIFT") << hex(ashift) << std::endl;
         os << tab("BBUSY") << bol(bbusy) << std::endl;
         os << tab("BZERO") << bol(bzero) << std::endl;
+        os << std::endl;
+        os << tab("Guarded range") << hex(guardStart) << " - " << hex(guardStart + guardLen) << std::endl;
+        os << tab("Slow Blitter until frame") << dec(exactUntil) << std::endl;
+        os << tab("Detected conflicts") << dec(conflicts) << std::endl;
     }
 }
 
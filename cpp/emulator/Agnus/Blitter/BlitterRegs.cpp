@@ -26,6 +26,8 @@ Blitter::setBLTCON0(u16 value)
 {
     if (running) {
         trace(BLT_REG_GUARD, "BLTCON0 written while Blitter is running\n");
+        checkRegAccess();
+        programMask = 0;
     }
 
     bltcon0 = value;
@@ -47,6 +49,8 @@ Blitter::setBLTCON0L(u16 value)
 {
     if (running) {
         trace(BLT_REG_GUARD, "BLTCON0L written while Blitter is running\n");
+        checkRegAccess();
+        programMask = 0;
     }
     
     bltcon0 = HI_LO(HI_BYTE(bltcon0), LO_BYTE(value));
@@ -102,6 +106,8 @@ Blitter::setBLTCON1(u16 value)
 {
     if (running) {
         trace(BLT_REG_GUARD, "BLTCON1 written while Blitter is running\n");
+        checkRegAccess();
+        programMask = 0;
     }
     
     bltcon1 = value;
@@ -152,6 +158,7 @@ Blitter::pokeBLTAPTH(u16 value)
 
     if (running) {
         trace(BLT_REG_GUARD, "BLTAPTH written while Blitter is running\n");
+        checkRegAccess();
     }
 
     bltapt = REPLACE_HI_WORD(bltapt, value);
@@ -168,6 +175,7 @@ Blitter::pokeBLTAPTL(u16 value)
     
     if(running) {
         trace(BLT_REG_GUARD, "BLTAPTL written while Blitter is running\n");
+        checkRegAccess();
     }
 
     bltapt = REPLACE_LO_WORD(bltapt, value & 0xFFFE);
@@ -180,6 +188,7 @@ Blitter::pokeBLTBPTH(u16 value)
     
     if(running) {
         trace(BLT_REG_GUARD, "BLTBPTH written while Blitter is running\n");
+        checkRegAccess();
     }
     
     bltbpt = REPLACE_HI_WORD(bltbpt, value);
@@ -196,6 +205,7 @@ Blitter::pokeBLTBPTL(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTBPTL written while Blitter is running\n");
+        checkRegAccess();
     }
 
     bltbpt = REPLACE_LO_WORD(bltbpt, value & 0xFFFE);
@@ -208,6 +218,7 @@ Blitter::pokeBLTCPTH(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTCPTH written while Blitter is running\n");
+        checkRegAccess();
     }
     
     bltcpt = REPLACE_HI_WORD(bltcpt, value);
@@ -224,6 +235,7 @@ Blitter::pokeBLTCPTL(u16 value)
     
     if(running) {
         trace(BLT_REG_GUARD, "BLTCPTL written while Blitter is running\n");
+        checkRegAccess();
     }
 
     bltcpt = REPLACE_LO_WORD(bltcpt, value & 0xFFFE);
@@ -236,6 +248,7 @@ Blitter::pokeBLTDPTH(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTDPTH written while Blitter is running\n");
+        checkRegAccess();
     }
 
     bltdpt = REPLACE_HI_WORD(bltdpt, value);
@@ -252,6 +265,7 @@ Blitter::pokeBLTDPTL(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTDPTL written while Blitter is running\n");
+        checkRegAccess();
     }
     
     bltdpt = REPLACE_LO_WORD(bltdpt, value & 0xFFFE);
@@ -264,6 +278,7 @@ Blitter::pokeBLTAFWM(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTAFWM written while Blitter is running\n");
+        checkRegAccess();
     }
 
     bltafwm = value;
@@ -276,6 +291,7 @@ Blitter::pokeBLTALWM(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTALWM written while Blitter is running\n");
+        checkRegAccess();
     }
 
     bltalwm = value;
@@ -297,6 +313,7 @@ Blitter::setBLTSIZE(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTSIZE written while Blitter is running\n");
+        checkRegAccess();
     }
 
     // Execute pending event if the Blitter is still running (Chaosland, #437)
@@ -336,6 +353,7 @@ Blitter::setBLTSIZV(u16 value)
 {
     if (running) {
         trace(BLT_REG_GUARD, "BLTSIZV written while Blitter is running\n");
+        checkRegAccess();
     }
 
     // 15  14  13  12  11  10 09 08 07 06 05 04 03 02 01 00
@@ -353,6 +371,7 @@ Blitter::pokeBLTSIZH(u16 value)
 
     if (running) {
         trace(BLT_REG_GUARD, "BLTSIZH written while Blitter is running\n");
+        checkRegAccess();
     }
 
     // Execute pending event if the Blitter is still running
@@ -376,6 +395,7 @@ Blitter::pokeBLTAMOD(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTAMOD written while Blitter is running\n");
+        checkRegAccess();
     }
 
     bltamod = (i16)(value & 0xFFFE);
@@ -387,6 +407,7 @@ Blitter::pokeBLTBMOD(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTBMOD written while Blitter is running\n");
+        checkRegAccess();
     }
     
     bltbmod = (i16)(value & 0xFFFE);
@@ -399,6 +420,7 @@ Blitter::pokeBLTCMOD(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTCMOD written while Blitter is running\n");
+        checkRegAccess();
     }
 
     bltcmod = (i16)(value & 0xFFFE);
@@ -411,6 +433,7 @@ Blitter::pokeBLTDMOD(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTDMOD written while Blitter is running\n");
+        checkRegAccess();
     }
     
     bltdmod = (i16)(value & 0xFFFE);
@@ -423,6 +446,7 @@ Blitter::pokeBLTADAT(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTADAT written while Blitter is running\n");
+        checkRegAccess();
     }
     
     anew = value;
@@ -435,6 +459,7 @@ Blitter::pokeBLTBDAT(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTBDAT written while Blitter is running\n");
+        checkRegAccess();
     }
     
     bnew = value;
@@ -455,6 +480,7 @@ Blitter::pokeBLTCDAT(u16 value)
     
     if (running) {
         trace(BLT_REG_GUARD, "BLTCDAT written while Blitter is running\n");
+        checkRegAccess();
     }
     
     chold = value;
@@ -0,0 +1,293 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "Blitter.h"
+#include "Amiga.h"
+#include "Checksum.h"
+#include "Chrono.h"
+#include "IOUtils.h"
+#include <fstream>
+
+namespace vamiga {
+
+void
+Blitter::startTrace()
+{
+    {   SUSPENDED
+
+        traceItems.clear();
+        traceRam.assign(mem.chip, mem.chip + mem.chipRamSize());
+        tracing = true;
+    }
+}
+
+void
+Blitter::stopTrace()
+{
+    {   SUSPENDED
+
+        tracing = false;
+    }
+}
+
+void
+Blitter::recordBlitStart(isize level)
+{
+    // Stop recording if the trace is full
+    if (isize(traceItems.size()) >= traceCapacity) {
+
+        warn("Blitter trace is full. Recording stopped.\n");
+        tracing = false;
+        return;
+    }
+
+    BlitTraceItem item = {
+
+        .bltcon0 = bltcon0,
+        .bltcon1 = bltcon1,
+        .bltapt = bltapt,
+        .bltbpt = bltbpt,
+        .bltcpt = bltcpt,
+        .bltdpt = bltdpt,
+        .bltafwm = bltafwm,
+        .bltalwm = bltalwm,
+        .bltsizeH = bltsizeH,
+        .bltsizeV = bltsizeV,
+        .bltamod = bltamod,
+        .bltbmod = bltbmod,
+        .bltcmod = bltcmod,
+        .bltdmod = bltdmod,
+        .bltadat = anew,
+        .bltbdat = bnew,
+        .bltcdat = chold,
+        .accuracy = u8(level),
+        .start = agnus.clock,
+        .duration = 0
+    };
+
+    traceItems.push_back(item);
+}
+
+void
+Blitter::recordBlitEnd()
+{
+    if (!traceItems.empty()) {
+
+        auto &item = traceItems.back();
+        item.duration = agnus.clock - item.start;
+    }
+}
+
+void
+Blitter::saveTrace(const fs::path &path) const
+{
+    /* The trace file is organized as follows:
+     *
+     *   "BLTT" | Version (2) | RAM size (4) | RAM image | Count (4) | Items
+     *
+     * All values are stored in big endian format. Each item occupies 56 bytes.
+     */
+    std::vector<u8> data;
+
+    auto w8 = [&](u8 value) { data.push_back(value); };
+    auto w16 = [&](u16 value) { w8(HI_BYTE(value)); w8(LO_BYTE(value)); };
+    auto w32 = [&](u32 value) { w16(HI_WORD(value)); w16(LO_WORD(value)); };
+    auto w64 = [&](u64 value) { w32(u32(value >> 32)); w32(u32(value)); };
+
+    for (auto c : { 'B', 'L', 'T', 'T' }) w8(c);
+    w16(1);
+    w32(u32(traceRam.size()));
+    data.insert(data.end(), traceRam.begin(), traceRam.end());
+    w32(u32(traceItems.size()));
+
+    for (auto &item : traceItems) {
+
+        w16(item.bltcon0);
+        w16(item.bltcon1);
+        w32(item.bltapt);
+        w32(item.bltbpt);
+        w32(item.bltcpt);
+        w32(item.bltdpt);
+        w16(item.bltafwm);
+        w16(item.bltalwm);
+        w16(item.bltsizeH);
+        w16(item.bltsizeV);
+        w16(item.bltamod);
+        w16(item.bltbmod);
+        w16(item.bltcmod);
+        w16(item.bltdmod);
+        w16(item.bltadat);
+        w16(item.bltbdat);
+        w16(item.bltcdat);
+        w16(item.accuracy);
+        w64(item.start);
+        w32(u32(item.duration));
+    }
+
+    auto stream = std::ofstream(path, std::ofstream::binary);
+
+    if (!stream.is_open()) {
+        throw VAError(ERROR_FILE_CANT_WRITE, path.string());
+    }
+    stream.write((const char *)data.data(), data.size());
+}
+
+u32
+Blitter::replayBlits(isize level, isize &stalled)
+{
+    std::memcpy(mem.chip, traceRam.data(), traceRam.size());
+    stalled = -1;
+
+    // Make sure the Slow Blitter is granted the bus in every cycle
+    agnus.dmacon |= DMAEN | BLTEN;
+    agnus.setBLS(false);
+
+    for (isize nr = 0; nr < isize(traceItems.size()); nr++) {
+
+        auto &item = traceItems[nr];
+
+        bltcon0 = item.bltcon0;
+        bltcon1 = item.bltcon1;
+        bltapt = item.bltapt;
+        bltbpt = item.bltbpt;
+        bltcpt = item.bltcpt;
+        bltdpt = item.bltdpt;
+        bltafwm = item.bltafwm;
+        bltalwm = item.bltalwm;
+        bltsizeH = item.bltsizeH;
+        bltsizeV = item.bltsizeV;
+        bltamod = item.bltamod;
+        bltbmod = item.bltbmod;
+        bltcmod = item.bltcmod;
+        bltdmod = item.bltdmod;
+
+        prepareBlit();
+
+        anew = item.bltadat;
+        bnew = item.bltbdat;
+        chold = item.bltcdat;
+
+        // Don't let the replay trigger a Blitter interrupt
+        birq = true;
+
+        // Level -1 replays each blit with the level it was recorded with
+        if ((level < 0 ? item.accuracy : level) == 2) {
+
+            // Execute the whole micro program immediately
+            BusOwner owner = agnus.busOwner[agnus.pos.h];
+
+            if (bltconLINE()) {
+                beginSlowLineBlit();
+            } else {
+                beginSlowCopyBlit();
+            }
+
+            // No micro program takes more than 8 steps per word
+            isize cycles = 8 * (isize(bltsizeH) * isize(bltsizeV) + 2);
+
+            for (; agnus.hasEvent<SLOT_BLT>() && cycles; cycles--) {
+                agnus.busOwner[agnus.pos.h] = BUS_NONE;
+                serviceEvent();
+            }
+
+            agnus.busOwner[agnus.pos.h] = owner;
+
+            if (agnus.hasEvent<SLOT_BLT>()) {
+
+                agnus.cancel<SLOT_BLT>();
+                running = false;
+                stalled = nr;
+                break;
+            }
+
+        } else {
+
+            if (bltconLINE()) {
+                doFastLineBlit();
+            } else {
+                runFastCopyBlit();
+            }
+        }
+    }
+
+    return util::fnv32(mem.chip, mem.chipRamSize());
+}
+
+void
+Blitter::replayTrace(std::ostream &os)
+{
+    /* Replays all recorded blits on the Chip RAM image that was taken when the
+     * recording was started. The blits are replayed three times: With the
+     * accuracy level they were recorded with, with the Fast Blitter, and with
+     * the Slow Blitter. The Slow Blitter executes its micro programs in one
+     * chunk, just like it does if SLOW_BLT_DEBUG is set.
+     */
+    using namespace util;
+
+    {   SUSPENDED
+
+        if (traceRam.size() != usize(mem.chipRamSize())) {
+            throw VAError(ERROR_OPT_INVARG, "No trace recorded");
+        }
+
+        // Save the state that gets modified by the replay
+        std::vector<u8> state(agnus.size());
+        agnus.save(state.data());
+        std::vector<u8> ram(mem.chip, mem.chip + mem.chipRamSize());
+        auto dataBus = mem.dataBus;
+        auto wasTracing = tracing;
+        auto wasUndoable = undoable;
+        tracing = false;
+        undoable = false;
+
+        Cycle duration = 0;
+        for (auto &item : traceItems) duration += item.duration;
+
+        u32 checksum[3];
+        util::Time elapsed[3];
+        isize stalled[3];
+
+        for (isize i = 0; i < 3; i++) {
+
+            Clock clock;
+            checksum[i] = replayBlits(i == 0 ? -1 : i == 1 ? 0 : 2, stalled[i]);
+            elapsed[i] = clock.stop();
+        }
+
+        // Restore the original state
+        std::memcpy(mem.chip, ram.data(), ram.size());
+        mem.dataBus = dataBus;
+        agnus.load(state.data());
+        tracing = wasTracing;
+        undoable = wasUndoable;
+
+        auto result = [&](const char *name, isize i) {
+
+            os << tab(name);
+            if (stalled[i] >= 0) {
+                os << "ERROR: Blit " << dec(stalled[i]) << " did not terminate" << std::endl;
+                return;
+            }
+            os << hex(checksum[i]) << " (" << dec(elapsed[i].asMicroseconds()) << " usec)";
+            if (i && stalled[0] < 0 && checksum[i] != checksum[0]) os << " MISMATCH";
+            os << std::endl;
+        };
+
+        os << tab("Blits");
+        os << dec(traceItems.size()) << std::endl;
+        os << tab("Emulated duration");
+        os << dec(AS_DMA_CYCLES(duration)) << " DMA cycles" << std::endl;
+        result("Recorded accuracy", 0);
+        result("Fast Blitter", 1);
+        result("Slow Blitter", 2);
+    }
+}
+
+}
@@ -99,3 +99,33 @@ typedef struct
     bool storeToDest;
 }
 BlitterInfo;
+
+typedef struct
+{
+    // Register values at the beginning of the blit
+    u16 bltcon0;
+    u16 bltcon1;
+    u32 bltapt;
+    u32 bltbpt;
+    u32 bltcpt;
+    u32 bltdpt;
+    u16 bltafwm;
+    u16 bltalwm;
+    u16 bltsizeH;
+    u16 bltsizeV;
+    i16 bltamod;
+    i16 bltbmod;
+    i16 bltcmod;
+    i16 bltdmod;
+    u16 bltadat;
+    u16 bltbdat;
+    u16 bltcdat;
+
+    // Accuracy level the blit was performed with
+    u8 accuracy;
+
+    // Master cycle the blit started in and its duration in master cycles
+    Cycle start;
+    Cycle duration;
+}
+BlitTraceItem;
@@ -16,26 +16,47 @@
 
 namespace vamiga {
 
+/* Minterms for which the Fast Blitter provides specialized blit functions.
+ * All other minterms are handled by a generic blit function (0x100).
+ */
+#define MT_CLEAR    0x00
+#define MT_COPY_A   0xF0
+#define MT_COOKIE   0xCA
+#define MT_XOR_AC   0x5A
+#define MT_GENERIC  0x100
+
+#define BLITFUNCS(fill, mt) { \
+&Blitter::doFastCopyBlit<0,0,0,0,0,fill,mt>, &Blitter::doFastCopyBlit<0,0,0,0,1,fill,mt>, \
+&Blitter::doFastCopyBlit<0,0,0,1,0,fill,mt>, &Blitter::doFastCopyBlit<0,0,0,1,1,fill,mt>, \
+&Blitter::doFastCopyBlit<0,0,1,0,0,fill,mt>, &Blitter::doFastCopyBlit<0,0,1,0,1,fill,mt>, \
+&Blitter::doFastCopyBlit<0,0,1,1,0,fill,mt>, &Blitter::doFastCopyBlit<0,0,1,1,1,fill,mt>, \
+&Blitter::doFastCopyBlit<0,1,0,0,0,fill,mt>, &Blitter::doFastCopyBlit<0,1,0,0,1,fill,mt>, \
+&Blitter::doFastCopyBlit<0,1,0,1,0,fill,mt>, &Blitter::doFastCopyBlit<0,1,0,1,1,fill,mt>, \
+&Blitter::doFastCopyBlit<0,1,1,0,0,fill,mt>, &Blitter::doFastCopyBlit<0,1,1,0,1,fill,mt>, \
+&Blitter::doFastCopyBlit<0,1,1,1,0,fill,mt>, &Blitter::doFastCopyBlit<0,1,1,1,1,fill,mt>, \
+&Blitter::doFastCopyBlit<1,0,0,0,0,fill,mt>, &Blitter::doFastCopyBlit<1,0,0,0,1,fill,mt>, \
+&Blitter::doFastCopyBlit<1,0,0,1,0,fill,mt>, &Blitter::doFastCopyBlit<1,0,0,1,1,fill,mt>, \
+&Blitter::doFastCopyBlit<1,0,1,0,0,fill,mt>, &Blitter::doFastCopyBlit<1,0,1,0,1,fill,mt>, \
+&Blitter::doFastCopyBlit<1,0,1,1,0,fill,mt>, &Blitter::doFastCopyBlit<1,0,1,1,1,fill,mt>, \
+&Blitter::doFastCopyBlit<1,1,0,0,0,fill,mt>, &Blitter::doFastCopyBlit<1,1,0,0,1,fill,mt>, \
+&Blitter::doFastCopyBlit<1,1,0,1,0,fill,mt>, &Blitter::doFastCopyBlit<1,1,0,1,1,fill,mt>, \
+&Blitter::doFastCopyBlit<1,1,1,0,0,fill,mt>, &Blitter::doFastCopyBlit<1,1,1,0,1,fill,mt>, \
+&Blitter::doFastCopyBlit<1,1,1,1,0,fill,mt>, &Blitter::doFastCopyBlit<1,1,1,1,1,fill,mt> }
+
+#define BLITFUNCS_FILL(fill) { \
+BLITFUNCS(fill, MT_CLEAR), \
+BLITFUNCS(fill, MT_COPY_A), \
+BLITFUNCS(fill, MT_COOKIE), \
+BLITFUNCS(fill, MT_XOR_AC), \
+BLITFUNCS(fill, MT_GENERIC) }
+
 void
 Blitter::initFastBlitter()
 {
-    void (Blitter::*blitfunc[32])(void) = {
-        &Blitter::doFastCopyBlit<0,0,0,0,0>, &Blitter::doFastCopyBlit<0,0,0,0,1>,
-        &Blitter::doFastCopyBlit<0,0,0,1,0>, &Blitter::doFastCopyBlit<0,0,0,1,1>,
-        &Blitter::doFastCopyBlit<0,0,1,0,0>, &Blitter::doFastCopyBlit<0,0,1,0,1>,
-        &Blitter::doFastCopyBlit<0,0,1,1,0>, &Blitter::doFastCopyBlit<0,0,1,1,1>,
-        &Blitter::doFastCopyBlit<0,1,0,0,0>, &Blitter::doFastCopyBlit<0,1,0,0,1>,
-        &Blitter::doFastCopyBlit<0,1,0,1,0>, &Blitter::doFastCopyBlit<0,1,0,1,1>,
-        &Blitter::doFastCopyBlit<0,1,1,0,0>, &Blitter::doFastCopyBlit<0,1,1,0,1>,
-        &Blitter::doFastCopyBlit<0,1,1,1,0>, &Blitter::doFastCopyBlit<0,1,1,1,1>,
-        &Blitter::doFastCopyBlit<1,0,0,0,0>, &Blitter::doFastCopyBlit<1,0,0,0,1>,
-        &Blitter::doFastCopyBlit<1,0,0,1,0>, &Blitter::doFastCopyBlit<1,0,0,1,1>,
-        &Blitter::doFastCopyBlit<1,0,1,0,0>, &Blitter::doFastCopyBlit<1,0,1,0,1>,
-        &Blitter::doFastCopyBlit<1,0,1,1,0>, &Blitter::doFastCopyBlit<1,0,1,1,1>,
-        &Blitter::doFastCopyBlit<1,1,0,0,0>, &Blitter::doFastCopyBlit<1,1,0,0,1>,
-        &Blitter::doFastCopyBlit<1,1,0,1,0>, &Blitter::doFastCopyBlit<1,1,0,1,1>,
-        &Blitter::doFastCopyBlit<1,1,1,0,0>, &Blitter::doFastCopyBlit<1,1,1,0,1>,
-        &Blitter::doFastCopyBlit<1,1,1,1,0>, &Blitter::doFastCopyBlit<1,1,1,1,1>
+    void (Blitter::*blitfunc[2][5][32])(void) = {
+
+        BLITFUNCS_FILL(false),
+        BLITFUNCS_FILL(true)
     };
 
     assert(sizeof(this->blitfunc) == sizeof(blitfunc));
@@ -49,8 +70,7 @@ Blitter::beginFastCopyBlit()
     assert(!bltconLINE());
 
     // Run the fast copy Blitter
-    isize nr = ((bltcon0 >> 7) & 0b11110) | (bltconDESC() ? 1 : 0);
-    (this->*blitfunc[nr])();
+    runFastCopyBlit();
 
     // Terminate immediately
     clearBusyFlag();
@@ -73,7 +93,40 @@ Blitter::beginFastLineBlit()
     endBlit();
 }
 
-template <bool useA, bool useB, bool useC, bool useD, bool desc>
+void
+Blitter::runFastCopyBlit()
+{
+    isize mt;
+
+    switch (bltcon0 & 0xFF) {
+
+        case MT_CLEAR:  mt = 0; break;
+        case MT_COPY_A: mt = 1; break;
+        case MT_COOKIE: mt = 2; break;
+        case MT_XOR_AC: mt = 3; break;
+        default:        mt = 4; break;
+    }
+
+    isize nr = ((bltcon0 >> 7) & 0b11110) | (bltconDESC() ? 1 : 0);
+    (this->*blitfunc[bltconFE() ? 1 : 0][mt][nr])();
+}
+
+template <u16 minterm> u16
+Blitter::doMintermLogic(u16 a, u16 b, u16 c) const
+{
+    switch (minterm) {
+
+        case MT_CLEAR:  return 0;
+        case MT_COPY_A: return a;
+        case MT_COOKIE: return (a & b) | (~a & c);
+        case MT_XOR_AC: return a ^ c;
+
+        default:
+            return doMintermLogic(a, b, c, bltcon0 & 0xFF);
+    }
+}
+
+template <bool useA, bool useB, bool useC, bool useD, bool desc, bool fill, u16 minterm>
 void Blitter::doFastCopyBlit()
 {
     u32 apt = bltapt;
@@ -81,7 +134,6 @@ void Blitter::doFastCopyBlit()
     u32 cpt = bltcpt;
     u32 dpt = bltdpt;
 
-    bool fill = bltconFE();
     bool fillCarry;
 
     int incr = desc ? -2 : 2;
@@ -93,11 +145,37 @@ void Blitter::doFastCopyBlit()
     aold = 0;
     bold = 0;
 
+    // Checks if D overwrites a source word of the same line before it is read
+    auto overlaps = [&](const u8 *src, const u8 *dst) {
+
+        if (!src || !dst) return false;
+        return desc ? (src > dst && src - dst < 2 * bltsizeH) :
+                      (src < dst && dst - src < 2 * bltsizeH);
+    };
+
     for (isize y = 0; y < bltsizeV; y++) {
 
         // Reset the fill carry bit
         fillCarry = !!bltconFCI();
 
+        // Process the entire line at once if it is located in Chip RAM
+        u8 *pa = useA ? chipRamRow(apt, desc) : nullptr;
+        u8 *pb = useB ? chipRamRow(bpt, desc) : nullptr;
+        u8 *pc = useC ? chipRamRow(cpt, desc) : nullptr;
+        u8 *pd = useD ? chipRamRow(dpt, desc) : nullptr;
+
+        if ((!useA || pa) && (!useB || pb) && (!useC || pc) && (!useD || pd) &&
+            !overlaps(pa, pd) && !overlaps(pb, pd) && !overlaps(pc, pd)) {
+
+            doFastCopyRow<useA, useB, useC, useD, desc, fill, minterm>(pa, pb, pc, pd, dpt, fillCarry);
+
+            if (useA) apt = U32_ADD(apt, incr * bltsizeH + amod);
+            if (useB) bpt = U32_ADD(bpt, incr * bltsizeH + bmod);
+            if (useC) cpt = U32_ADD(cpt, incr * bltsizeH + cmod);
+            if (useD) dpt = U32_ADD(dpt, incr * bltsizeH + dmod);
+            continue;
+        }
+
         // Apply the "first word mask" in the first iteration
         u16 mask = bltafwm;
 
@@ -138,7 +216,7 @@ void Blitter::doFastCopyBlit()
             }
             
             // Run the minterm circuit
-            dhold = doMintermLogic(ahold, bhold, chold, bltcon0 & 0xFF);
+            dhold = doMintermLogic<minterm>(ahold, bhold, chold);
 
             // Run the fill logic circuit
             if (fill) doFill(dhold, fillCarry);
@@ -177,6 +255,132 @@ void Blitter::doFastCopyBlit()
     bltdpt = dpt;
 }
 
+template <bool useA, bool useB, bool useC, bool useD, bool desc, bool fill, u16 minterm>
+void Blitter::doFastCopyRow(const u8 *a, const u8 *b, const u8 *c, u8 *d, u32 dpt, bool &carry)
+{
+    /* This function performs the same computations as the inner loop of
+     * doFastCopyBlit(), but processes the line stage by stage. All stages
+     * except the fill stage are free of loop-carried dependencies and are
+     * vectorized by the compiler.
+     */
+    isize w = bltsizeH;
+    isize step = desc ? -2 : 2;
+    u16 ash = bltconASH();
+    u16 bsh = bltconBSH();
+    u16 lastA = anew;
+    u16 lastB = bnew;
+
+    // Fetch A (the first element holds the word from the previous line)
+    rowA[0] = aold;
+    if (useA) {
+        for (isize x = 0; x < w; x++) rowA[x + 1] = R16BE(a + step * x);
+        lastA = rowA[w];
+    } else {
+        for (isize x = 0; x < w; x++) rowA[x + 1] = anew;
+    }
+
+    // Apply the first and the last word mask
+    rowA[1] &= bltafwm;
+    rowA[w] &= bltalwm;
+
+    // Fetch B (the first element holds the word from the previous line)
+    if (useB) {
+        rowB[0] = bold;
+        for (isize x = 0; x < w; x++) rowB[x + 1] = R16BE(b + step * x);
+        lastB = rowB[w];
+    }
+
+    // Fetch C
+    if (useC) {
+        for (isize x = 0; x < w; x++) rowC[x] = R16BE(c + step * x);
+    }
+
+    // Expand the minterm bits into bit masks
+    u16 m[8];
+    for (isize i = 0; i < 8; i++) m[i] = (bltcon0 & (1 << i)) ? 0xFFFF : 0;
+
+    auto mux = [](u16 s, u16 x, u16 y) { return u16(y ^ (s & (x ^ y))); };
+
+    // Run the barrel shifters and the minterm circuit
+    u16 ah = ahold, bh = bhold, ch = chold;
+    for (isize x = 0; x < w; x++) {
+
+        if (desc) {
+            ah = u16((u32(rowA[x + 1]) << 16 | rowA[x]) >> (16 - ash));
+            if (useB) bh = u16((u32(rowB[x + 1]) << 16 | rowB[x]) >> (16 - bsh));
+        } else {
+            ah = u16((u32(rowA[x]) << 16 | rowA[x + 1]) >> ash);
+            if (useB) bh = u16((u32(rowB[x]) << 16 | rowB[x + 1]) >> bsh);
+        }
+        if (useC) ch = rowC[x];
+
+        if (minterm == MT_GENERIC) {
+            rowD[x] = mux(ah, mux(bh, mux(ch, m[7], m[6]), mux(ch, m[5], m[4])),
+                              mux(bh, mux(ch, m[3], m[2]), mux(ch, m[1], m[0])));
+        } else {
+            rowD[x] = doMintermLogic<minterm>(ah, bh, ch);
+        }
+    }
+
+    // Run the fill logic circuit
+    if (fill) {
+        for (isize x = 0; x < w; x++) doFill(rowD[x], carry);
+    }
+
+    // Update the zero flag
+    u16 any = 0;
+    for (isize x = 0; x < w; x++) any |= rowD[x];
+    if (any) bzero = false;
+
+    // Write D
+    if (useD) {
+
+        for (isize x = 0; x < w; x++) W16BE(d + step * x, rowD[x]);
+
+        if (BLT_CHECKSUM) {
+            for (isize x = 0; x < w; x++) {
+                check1 = util::fnvIt32(check1, rowD[x]);
+                check2 = util::fnvIt32(check2, U32_ADD(dpt, step * x) & agnus.ptrMask);
+            }
+        }
+    }
+
+    // Update the pipeline registers
+    anew = lastA;
+    aold = rowA[w];
+    ahold = ah;
+    if (useB) { bnew = lastB; bold = rowB[w]; bhold = bh; }
+    if (useC) chold = ch;
+    dhold = rowD[w - 1];
+
+    // Leave the last transferred word on the data bus
+    if (useD) mem.dataBus = dhold;
+    else if (useC) mem.dataBus = chold;
+    else if (useB) mem.dataBus = bnew;
+    else if (useA) mem.dataBus = anew;
+}
+
+u8 *
+Blitter::chipRamRow(u32 addr, bool desc) const
+{
+    u32 span = 2 * (bltsizeH - 1);
+    u32 first = addr & agnus.ptrMask;
+
+    // Make sure that the line doesn't wrap around
+    if (desc) {
+        if (first < span) return nullptr;
+        first -= span;
+    } else {
+        if (first + span > agnus.ptrMask) return nullptr;
+    }
+
+    // Make sure that the line is located in Chip RAM (excluding mirrors)
+    if (first + span + 1 > mem.chipMask) return nullptr;
+    if (mem.agnusMemSrc[first >> 16] != MEM_CHIP) return nullptr;
+
+    return mem.chip + (desc ? first + span : first);
+}
+
 void
 Blitter::doFastLineBlit()
 {
@@ -290,6 +494,7 @@ Blitter::doFastLineBlit()
         // Write D
         if (writeEnable) {
 
+            if (undoable) recordUndo(bltdpt);
             mem.poke16 <ACCESSOR_AGNUS> (bltdpt, dhold);
             
             if (BLT_CHECKSUM) {
@@ -404,6 +609,7 @@ Blitter::doLegacyFastLineBlit()
         
         // Save result to D-channel, same as the C ptr after first pixel.
         if (c_enabled) { // C-channel must be enabled
+            if (undoable) recordUndo(bltdpt_local);
             mem.poke16 <ACCESSOR_AGNUS> (bltdpt_local, bltddat_local);
 
             if (BLT_CHECKSUM) {
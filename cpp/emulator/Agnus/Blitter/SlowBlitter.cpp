@@ -957,9 +957,11 @@ Blitter::beginFakeCopyBlit()
     // Only call this function in copy mode
     assert(!bltconLINE());
 
+    // Remember what the fast Blitter overwrites
+    prepareUndo();
+
     // Run the fast Blitter
-    int nr = ((bltcon0 >> 7) & 0b11110) | !!bltconDESC();
-    (this->*blitfunc[nr])();
+    runFastCopyBlit();
 
     // Prepare the slow Blitter
     resetXCounter();
@@ -1015,6 +1017,9 @@ Blitter::beginFakeLineBlit()
     // Only call this function in line mode
     assert(bltconLINE());
 
+    // Remember what the fast Blitter overwrites
+    prepareUndo();
+
     // Do the blit
     doFastLineBlit();
 
@@ -1090,10 +1095,10 @@ Blitter::exec()
     }
     
     // Allocate the bus if needed
-    if (bus && !agnus.allocateBus<BUS_BLITTER>()) return;
+    if (bus && !agnus.allocateBus<BUS_BLITTER>()) { skipBlockedCycles(); return; }
 
     // Check if the Blitter needs a free bus to continue
-    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) return;
+    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) { skipBlockedCycles(); return; }
 
     bltpc++;
 
@@ -1242,6 +1247,10 @@ Blitter::fakeExec()
 {
     bool bus, busidle;
 
+    // Remember the instruction for batching
+    program[bltpc] = instr;
+    programMask |= u8(1 << bltpc);
+
     // Determine if we need the bus
     if constexpr ((bool)(instr & WRITE_D)) {
         bus     = !lockD;
@@ -1260,10 +1269,10 @@ Blitter::fakeExec()
     }
 
     // Allocate the bus if needed
-    if (bus && !agnus.allocateBus<BUS_BLITTER>()) return;
+    if (bus && !agnus.allocateBus<BUS_BLITTER>()) { skipBlockedCycles(); return; }
 
     // Check if the Blitter needs a free bus to continue
-    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) return;
+    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) { skipBlockedCycles(); return; }
 
     bltpc++;
 
@@ -1303,6 +1312,10 @@ Blitter::fakeExec()
 
         trace(BLT_DEBUG, "BLTDONE\n");
         endBlit();
+
+    } else {
+
+        batchFakeCycles<false>();
     }
 }
 
@@ -1353,10 +1366,10 @@ Blitter::execLine()
     }
     
     // Allocate the bus if needed
-    if (bus && !agnus.allocateBus<BUS_BLITTER>()) return;
+    if (bus && !agnus.allocateBus<BUS_BLITTER>()) { skipBlockedCycles(); return; }
 
     // Check if the Blitter needs a free bus to continue
-    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) return;
+    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) { skipBlockedCycles(); return; }
 
     bltpc++;
 
@@ -1449,6 +1462,10 @@ Blitter::fakeExecLine()
 {
     bool bus, busidle;
 
+    // Remember the instruction for batching
+    program[bltpc] = instr;
+    programMask |= u8(1 << bltpc);
+
     // Determine if we need the bus
     if constexpr ((bool)(instr & WRITE_D)) {
         bus     = true;
@@ -1467,10 +1484,10 @@ Blitter::fakeExecLine()
     }
     
     // Allocate the bus if needed
-    if (bus && !agnus.allocateBus<BUS_BLITTER>()) return;
+    if (bus && !agnus.allocateBus<BUS_BLITTER>()) { skipBlockedCycles(); return; }
 
     // Check if the Blitter needs a free bus to continue
-    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) return;
+    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) { skipBlockedCycles(); return; }
 
     bltpc++;
 
@@ -1501,7 +1518,166 @@ Blitter::fakeExecLine()
     if constexpr ((bool)(instr & BLTDONE)) {
 
         endBlit();
+
+    } else {
+
+        batchFakeCycles<true>();
+    }
+}
+
+void
+Blitter::skipBlockedCycles()
+{
+    /* If the upcoming cycles are blocked by bitplane or refresh DMA, there is
+     * no point in retrying in each of them. In that case, the event is moved
+     * to the first cycle in which the bus might be available again.
+     */
+    isize next = agnus.nextFreeCycle();
+
+    if (next > agnus.pos.h + 1) {
+
+        agnus.rescheduleRel<SLOT_BLT>(DMA_CYCLES(next - agnus.pos.h));
+        skipping = true;
+    }
+}
+
+template <bool line> void
+Blitter::batchFakeCycles()
+{
+    /* A fake micro-program only operates the bus. As long as no other
+     * component shows up, each micro-instruction gets its bus cycle and the
+     * program advances by one instruction per cycle. Hence, the upcoming
+     * cycles up to the next event of another component can be computed in
+     * advance. They are processed in one go and the bus is reserved for them.
+     * If the CPU accesses the bus in the middle of a batch, the batch is
+     * rolled back to the current cycle by syncFakeBatch().
+     */
+    if constexpr (NO_BLT_BATCHING) return;
+
+    // Only proceed if the next instruction is known
+    if (!(programMask & (1 << bltpc))) return;
+
+    // Only proceed if the Blitter is going to get the bus
+    if (!agnus.bltdma() || (agnus.getBLS() && !agnus.bltpri())) return;
+
+    // Don't look beyond the next event of another component
+    Cycle limit = agnus.trigger[SLOT_SEC];
+    for (isize i = SLOT_REG; i < SLOT_BLT; i++) limit = std::min(limit, agnus.trigger[i]);
+
+    // Determine the number of cycles to process
+    isize cycles = std::min(isize(AS_DMA_CYCLES(limit - agnus.clock)) - 1, HPOS_MAX - agnus.pos.h);
+    if (cycles < 2) return;
+
+    // Remember the current state
+    batchStart = agnus.clock;
+    batchPc = bltpc;
+    batchX = xCounter;
+    batchY = yCounter;
+    batchIteration = iteration;
+    batchLockD = lockD;
+
+    // Process as many cycles as possible
+    isize i = 0;
+    while (i < cycles && advanceFakeProgram<line>(agnus.pos.h + 1 + i)) i++;
+
+    // Continue regularly in the first cycle that hasn't been processed
+    if (i) {
+
+        batchCycles = i;
+        agnus.rescheduleAbs<SLOT_BLT>(agnus.clock + DMA_CYCLES(i + 1));
+    }
+}
+
+template <bool line> bool
+Blitter::advanceFakeProgram(isize h, bool replay)
+{
+    u16 instr = program[bltpc];
+
+    // Stop if the instruction is unknown or has side effects
+    if (!(programMask & (1 << bltpc))) return false;
+    if (instr & BLTDONE) return false;
+    if (instr & REPEAT) {
+        if (line ? yCounter == 1 : xCounter == 1 && yCounter == 1) return false;
+    }
+
+    if (!replay) {
+
+        // Stop if the bus is taken
+        if (agnus.busOwner[h] != BUS_NONE) return false;
+
+        // Reserve the bus if needed
+        bool bus = (instr & WRITE_D) ? (line || !lockD) : (instr & (FETCH | BUS));
+        if (bus) agnus.busOwner[h] = BUS_BLITTER;
+
+        // Record some fake data to make the DMA debugger happy
+        if (instr & (line ? (FETCH | BUS | WRITE_D) : (FETCH | WRITE_D))) {
+            agnus.busValue[h] = 0x8888;
+        }
+    }
+
+    bltpc++;
+
+    if (instr & REPEAT) {
+
+        iteration++;
+        lockD = false;
+        bltpc = 0;
+
+        if (!line && xCounter > 1) {
+
+            decXCounter();
+
+        } else {
+
+            resetXCounter();
+            decYCounter();
+        }
     }
+
+    return true;
+}
+
+void
+Blitter::rollbackFakeBatch()
+{
+    assert(batchCycles);
+
+    // Determine the number of batched cycles that have been reached
+    isize reached = AS_DMA_CYCLES(agnus.clock - batchStart);
+    isize first = agnus.pos.h - reached + 1;
+
+    if (reached < batchCycles) {
+
+        // Restore the state from the beginning of the batch
+        bltpc = batchPc;
+        setXCounter(batchX);
+        yCounter = batchY;
+        iteration = batchIteration;
+        lockD = batchLockD;
+
+        // Redo all cycles that have been reached
+        for (isize i = 0; i < reached; i++) {
+
+            if (bltconLINE()) {
+                advanceFakeProgram<true>(first + i, true);
+            } else {
+                advanceFakeProgram<false>(first + i, true);
+            }
+        }
+
+        // Release the bus for all other cycles
+        for (isize i = reached; i < batchCycles; i++) {
+
+            if (agnus.busOwner[first + i] == BUS_BLITTER) {
+                agnus.busOwner[first + i] = BUS_NONE;
+            }
+        }
+
+        // Continue regularly in the next cycle
+        agnus.rescheduleAbs<SLOT_BLT>(agnus.clock + DMA_CYCLES(1));
+    }
+
+    batchCycles = 0;
 }
 
 }
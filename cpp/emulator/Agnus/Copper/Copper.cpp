@@ -104,6 +104,37 @@ Copper::findMatchOld(Beam &match) const
 
 bool
 Copper::findMatch(Beam &match) const
+{
+    u32 beam = (u32)(agnus.pos.v << 8 | agnus.pos.h);
+    u32 comp = (u32)getVPHP() << 16 | getVMHM();
+    isize numLines = agnus.pos.vCnt();
+
+    auto &entry = waitCache[(coppc0 >> 2) & 0xFF];
+
+    // Compute the wake-up position if the cached result doesn't match
+    if (entry.coppc != coppc0 || entry.comp != comp ||
+        entry.beam != beam || entry.numLines != numLines) {
+
+        Beam result;
+
+        entry.coppc = coppc0;
+        entry.comp = comp;
+        entry.beam = beam;
+        entry.numLines = numLines;
+        entry.found = computeMatch(result);
+        entry.match = (u32)(result.v << 8 | result.h);
+    }
+
+    if (entry.found) {
+
+        match.v = entry.match >> 8;
+        match.h = entry.match & 0xFF;
+    }
+    return entry.found;
+}
+
+bool
+Copper::computeMatch(Beam &match) const
 {
     // Start searching at the current beam position
     u32 beam = (u32)(agnus.pos.v << 8 | agnus.pos.h);
@@ -19,6 +19,24 @@
 
 namespace vamiga {
 
+// Evaluation result of a WAIT command
+struct CopperWait {
+
+    // Location of the WAIT command
+    u32 coppc;
+
+    // Comparison position (upper half) and comparison mask (lower half)
+    u32 comp;
+
+    // Beam position and frame height the search has started with
+    u32 beam;
+    isize numLines;
+
+    // Wake-up position (only valid if the Copper wakes up in this frame)
+    bool found;
+    u32 match;
+};
+
 class Copper : public SubComponent
 {
     friend class Agnus;
@@ -66,6 +84,15 @@ private:
      */
     bool activeInThisFrame = false;
 
+    /* Cache storing the evaluation results of recently executed WAIT commands.
+     * Since most Copper lists don't change from frame to frame, the same WAIT
+     * command is usually evaluated at the same beam position over and over
+     * again. The cache is indexed by the location of the WAIT command. Each
+     * entry is validated against the instruction words fetched by the Copper,
+     * which makes an explicit invalidation unnecessary.
+     */
+    mutable CopperWait waitCache[256] = {};
+
 public:
 
     // Indicates if breakpoint or watchpoint checking is needed
@@ -201,6 +228,9 @@ private:
     bool findMatchOld(Beam &result) const; // DEPRECATED
     bool findMatch(Beam &result) const;
 
+    // Called by findMatch() if the result is not cached
+    bool computeMatch(Beam &result) const;
+
     // Called by findMatch() to determine the horizontal trigger position
     bool findHorizontalMatchOld(u32 &beam, u32 comp, u32 mask) const; // DEPRECATED
     bool findHorizontalMatch(u32 &beam, u32 comp, u32 mask) const;
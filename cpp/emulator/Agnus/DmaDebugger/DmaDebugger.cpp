@@ -17,6 +17,36 @@ DmaDebugger::DmaDebugger(Amiga &ref) : SubComponent(ref)
 {
 }
 
+void
+DmaDebugger::_dump(Category category, std::ostream& os) const
+{
+    using namespace util;
+
+    if (category == Category::Stats) {
+
+        auto lines = std::max(stats.lines, isize(1));
+
+        auto usage = [&](const char *name, const DmaUsage &u) {
+
+            os << tab(name);
+            os << std::left << std::setw(8) << dec(u.cycles);
+            os << "min " << std::setw(5) << dec(u.minPerLine);
+            os << "avg " << std::setw(8) << flt((10 * u.cycles / lines) / 10.0);
+            os << "max " << dec(u.maxPerLine) << std::endl;
+        };
+
+        os << tab("Frame");
+        os << dec(stats.frame) << std::endl;
+        os << tab("Lines");
+        os << dec(stats.lines) << std::endl;
+
+        for (isize i = 0; DmaChannelEnum::isValid(i); i++) {
+            usage(DmaChannelEnum::key(DmaChannel(i)), stats.channel[i]);
+        }
+        usage("IDLE", stats.idle);
+    }
+}
+
 void
 DmaDebugger::resetConfig()
 {
@@ -296,18 +326,47 @@ DmaDebugger::setColor(BusOwner owner, u32 rgba)
 
     // Compute the color variants used for drawing
     RgbColor color = RgbColor(rgba);
-    debugColor[owner][0] = color.shade(0.3);
-    debugColor[owner][1] = color.shade(0.1);
-    debugColor[owner][2] = color.tint(0.1);
-    debugColor[owner][3] = color.tint(0.3);
+    debugColor[owner][0] = GpuColor(color.shade(0.3)).rawValue;
+    debugColor[owner][1] = GpuColor(color.shade(0.1)).rawValue;
+    debugColor[owner][2] = GpuColor(color.tint(0.1)).rawValue;
+    debugColor[owner][3] = GpuColor(color.tint(0.3)).rawValue;
 }
 
 void
-DmaDebugger::eolHandler()
+DmaDebugger::recordStats()
 {
-    // Only proceed if DMA debugging has been turned on
-    if (!config.enabled) return;
+    isize owned[BUS_COUNT] = { };
+    isize used[DMA_CHANNEL_COUNT] = { };
+
+    // Count the cycles assigned to each bus owner
+    for (isize i = 0; i < agnus.pos.h; i++) owned[agnus.busOwner[i]]++;
+
+    // Merge the bus owners into DMA channels
+    used[DMA_CHANNEL_CPU] = owned[BUS_CPU];
+    used[DMA_CHANNEL_REFRESH] = owned[BUS_REFRESH];
+    used[DMA_CHANNEL_DISK] = owned[BUS_DISK];
+    used[DMA_CHANNEL_COPPER] = owned[BUS_COPPER];
+    used[DMA_CHANNEL_BLITTER] = owned[BUS_BLITTER];
+    for (isize i = 0; i < 4; i++) used[DMA_CHANNEL_AUDIO] += owned[BUS_AUD0 + i];
+    for (isize i = 0; i < 6; i++) used[DMA_CHANNEL_BITPLANE] += owned[BUS_BPL1 + i];
+    for (isize i = 0; i < 8; i++) used[DMA_CHANNEL_SPRITE] += owned[BUS_SPRITE0 + i];
+
+    auto record = [&](DmaUsage &u, isize cycles) {
+
+        u.cycles += cycles;
+        if (current.lines == 0 || cycles < u.minPerLine) u.minPerLine = cycles;
+        if (current.lines == 0 || cycles > u.maxPerLine) u.maxPerLine = cycles;
+    };
 
+    for (isize i = 0; i < DMA_CHANNEL_COUNT; i++) record(current.channel[i], used[i]);
+    record(current.idle, owned[BUS_NONE] + owned[BUS_BLOCKED]);
+
+    current.lines++;
+}
+
+void
+DmaDebugger::recordLine()
+{
     // Copy Agnus arrays before they get deleted
     std::memcpy(busValue, agnus.busValue, sizeof(agnus.busValue));
     std::memcpy(busOwner, agnus.busOwner, sizeof(agnus.busOwner));
@@ -317,13 +376,10 @@ DmaDebugger::eolHandler()
 }
 
 void
-DmaDebugger::hsyncHandler(isize vpos)
+DmaDebugger::drawLine(isize vpos)
 {
     assert(agnus.pos.h == 0x12);
 
-    // Only proceed if DMA debugging has been turned on
-    if (!config.enabled) return;
-
     // Draw first chunk (data from previous DMA line)
     auto *ptr1 = pixelEngine.workingPtr(vpos);
     computeOverlay(ptr1, HBLANK_MIN, HPOS_MAX, busOwner, busValue);
@@ -336,6 +392,8 @@ DmaDebugger::hsyncHandler(isize vpos)
 void
 DmaDebugger::computeOverlay(Texel *ptr, isize first, isize last, BusOwner *own, u16 *val)
 {
+    static constexpr u32 none[4] = { };
+
     double opacity = config.opacity / 100.0;
     double bgWeight = 0;
     double fgWeight = 0;
@@ -365,51 +423,54 @@ DmaDebugger::computeOverlay(Texel *ptr, isize first, isize last, BusOwner *own,
 
     }
 
-    for (isize i = first; i <= last; i++, ptr += 4) {
+    // Translate the bus owners into foreground colors
+    isize count = 4 * (last - first + 1);
+    for (isize i = first, j = 0; i <= last; i++, j += 4) {
 
-        BusOwner owner = own[i];
-        // u32 *ptr32 = (u32 *)ptr;
+        const u32 *col = visualize[own[i]] ? debugColor[own[i]] : none;
 
-        // Handle the easy case first: No foreground pixels
-        if (!visualize[owner]) {
+        overlay[j]     = col[(val[i] & 0xC000) >> 14];
+        overlay[j + 1] = col[(val[i] & 0x0C00) >> 10];
+        overlay[j + 2] = col[(val[i] & 0x00C0) >> 6];
+        overlay[j + 3] = col[(val[i] & 0x000C) >> 2];
+    }
 
-            if (bgWeight != 0.0) {
+    /* Blend the overlay into the texture. Foreground pixels are mixed with
+     * the texture pixel by fgWeight, all other pixels are shaded by bgWeight.
+     * The loop is free of branches and processes two color channels per
+     * 32-bit operation which allows the compiler to vectorize it.
+     */
+    u32 fgw = u32(fgWeight * 256 + 0.5);
+    u32 bgw = u32(bgWeight * 256 + 0.5);
 
-                ptr[0] = TEXEL(GpuColor(ptr[0]).shade(bgWeight).rawValue);
-                ptr[1] = TEXEL(GpuColor(ptr[1]).shade(bgWeight).rawValue);
-                ptr[2] = TEXEL(GpuColor(ptr[2]).shade(bgWeight).rawValue);
-                ptr[3] = TEXEL(GpuColor(ptr[3]).shade(bgWeight).rawValue);
-            }
-            continue;
-        }
+    for (isize j = 0; j < count; j++) {
 
-        // Get RGBA values of foreground pixels
-        GpuColor col0 = debugColor[owner][(val[i] & 0xC000) >> 14];
-        GpuColor col1 = debugColor[owner][(val[i] & 0x0C00) >> 10];
-        GpuColor col2 = debugColor[owner][(val[i] & 0x00C0) >> 6];
-        GpuColor col3 = debugColor[owner][(val[i] & 0x000C) >> 2];
+        u32 tex = u32(ptr[j]);
+        u32 fg = overlay[j];
 
-        if (fgWeight != 0.0) {
+        u32 a = fg ? fg : tex;
+        u32 b = fg ? tex : 0;
+        u32 w = fg ? fgw : bgw;
 
-            col0 = col0.mix(GpuColor(ptr[0]), fgWeight);
-            col1 = col1.mix(GpuColor(ptr[2]), fgWeight);
-            col2 = col2.mix(GpuColor(ptr[4]), fgWeight);
-            col3 = col3.mix(GpuColor(ptr[6]), fgWeight);
-        }
+        u32 rb = ((a & 0xFF00FF) * (256 - w) + (b & 0xFF00FF) * w) >> 8;
+        u32 g = ((a & 0x00FF00) * (256 - w) + (b & 0x00FF00) * w) >> 8;
 
-        ptr[0] = TEXEL(col0.rawValue);
-        ptr[1] = TEXEL(col1.rawValue);
-        ptr[2] = TEXEL(col2.rawValue);
-        ptr[3] = TEXEL(col3.rawValue);
+        ptr[j] = TEXEL((rb & 0xFF00FF) | (g & 0x00FF00) | 0xFF000000);
     }
 }
 
 void
-DmaDebugger::vSyncHandler()
+DmaDebugger::eofHandler()
 {
-    // Only proceed if the debugger is enabled
-    if (!config.enabled) return;
+    // Publish the statistics of the completed frame
+    current.frame = agnus.pos.frame - 1;
+    stats = current;
+    current = { };
+}
 
+void
+DmaDebugger::clearVBlankArea()
+{
     // Clear old data in the VBLANK area of the next frame
     for (isize row = 0; row < VBLANK_CNT; row++) {
 
@@ -421,10 +482,4 @@ DmaDebugger::vSyncHandler()
     }
 }
 
-void
-DmaDebugger::eofHandler()
-{
-
-}
-
 }
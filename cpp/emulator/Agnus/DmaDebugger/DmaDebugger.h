@@ -26,7 +26,7 @@ class DmaDebugger : public SubComponent {
     bool visualize[BUS_COUNT] = {};
     
     // Colors used for highlighting DMA (derived from config.debugColor)
-    RgbColor debugColor[BUS_COUNT][5] = {};
+    u32 debugColor[BUS_COUNT][4] = {};
 
     // A local copy of the bus value table (recorded in the EOL handler)
     u16 busValue[HPOS_CNT];
@@ -37,6 +37,15 @@ class DmaDebugger : public SubComponent {
     // HSYNC handler information (recorded in the EOL handler)
     isize pixel0 = 0;
 
+    // Foreground color of each pixel in the overlay (0 = no foreground)
+    u32 overlay[4 * HPOS_CNT];
+
+    // Bus usage statistics of the current frame
+    DmaDebuggerStats current = {};
+
+    // Bus usage statistics of the previous frame
+    DmaDebuggerStats stats = {};
+
 
     //
     // Initializing
@@ -54,7 +63,7 @@ public:
 private:
     
     const char *getDescription() const override { return "DmaDebugger"; }
-    void _dump(Category category, std::ostream& os) const override { }
+    void _dump(Category category, std::ostream& os) const override;
 
     
     //
@@ -63,7 +72,7 @@ private:
     
 private:
     
-    void _reset(bool hard) override { }
+    void _reset(bool hard) override { current = stats = { }; }
 
 
     //
@@ -95,6 +104,9 @@ public:
     // Returns the result of the most recent call to inspect()
     DmaDebuggerInfo getInfo();
 
+    // Returns the bus usage statistics of the most recently completed frame
+    const DmaDebuggerStats &getStats() const { return stats; }
+
     
     //
     // Serializing
@@ -115,19 +127,31 @@ private:
 public:
     
     // Called by Agnus at the end of each scanline
-    void eolHandler();
+    void eolHandler() { recordStats(); if (config.enabled) recordLine(); }
 
     // Called by Agnus at the beginning of the HSYNC area
-    void hsyncHandler(isize vpos);
+    void hsyncHandler(isize vpos) { if (config.enabled) drawLine(vpos); }
 
     // Cleans by Agnus at the end of each frame
-    void vSyncHandler();
+    void vSyncHandler() { if (config.enabled) clearVBlankArea(); }
 
     // Called at the end of each frame
     void eofHandler();
 
 private:
 
+    // Adds the bus usage of the current line to the statistics
+    void recordStats();
+
+    // Records the bus usage of the current line
+    void recordLine();
+
+    // Superimposes the bus usage of the previous line
+    void drawLine(isize vpos);
+
+    // Clears the VBLANK area of the next frame
+    void clearVBlankArea();
+
     // Visualizes DMA usage for a certain range of DMA cycles
     void computeOverlay(Texel *ptr, isize first, isize last, BusOwner *own, u16 *val);
 };
@@ -129,3 +129,30 @@ typedef struct
     double refreshColor[3];
 }
 DmaDebuggerInfo;
+
+typedef struct
+{
+    // Number of DMA cycles in the frame
+    isize cycles;
+
+    // Minimum and maximum number of DMA cycles per line
+    isize minPerLine;
+    isize maxPerLine;
+}
+DmaUsage;
+
+typedef struct
+{
+    // The frame these statistics belong to
+    i64 frame;
+
+    // Number of recorded lines
+    isize lines;
+
+    // Bus usage of each DMA channel
+    DmaUsage channel[DMA_CHANNEL_COUNT];
+
+    // Cycles in which the bus was not used
+    DmaUsage idle;
+}
+DmaDebuggerStats;
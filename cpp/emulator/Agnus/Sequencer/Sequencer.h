@@ -67,6 +67,11 @@ namespace vamiga {
  * Whenever one the DMA tables is modified, the corresponding jump table
  * has to be updated, too.
  *
+ * The BPL jump table is accompanied by a third table called nextFreeCycle.
+ * It points to the next DMA cycle which is neither occupied by a bitplane
+ * fetch nor by a refresh cycle. The CPU and the Blitter utilize this table to
+ * jump over blocks of DMA cycles in which they can't get hold of the bus.
+ *
  * To quickly setup the DAS event table, vAmiga utilizes a static lookup table.
  * Depending on the current DMA status, segments of this table are copied to
  * the event table.
@@ -143,6 +148,9 @@ public:
     // Jump tables connecting the scheduled events
     u8 nextBplEvent[HPOS_CNT];
     u8 nextDasEvent[HPOS_CNT];
+
+    // Jump table pointing to the next cycle not blocked by a fixed DMA slot
+    u8 nextFreeCycle[HPOS_CNT];
     
     
     //
@@ -245,6 +253,7 @@ private:
         << dasEvent
         << nextBplEvent
         << nextDasEvent
+        << nextFreeCycle
 
         << ddfstrt
         << ddfstop
@@ -313,7 +322,7 @@ private:
     // Processes a signal change
     template <bool ecs> void processSignal(u32 signal, DDFState &state);
 
-    // Updates the jump table for the bplEvent table
+    // Updates the jump tables for the bplEvent table
     void updateBplJumpTable(i16 end = HPOS_MAX);
 
     // Computes the layout of a single fetch unit
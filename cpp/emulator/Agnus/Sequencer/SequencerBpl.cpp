@@ -18,6 +18,7 @@ Sequencer::initBplEvents()
 {
     for (isize i = 0; i < HPOS_CNT; i++) bplEvent[i] = EVENT_NONE;
     for (isize i = 0; i < HPOS_CNT; i++) nextBplEvent[i] = HPOS_MAX;
+    updateBplJumpTable();
 }
 
 void
@@ -65,8 +66,9 @@ Sequencer::computeBplEventTable(const SigRecorder &sr)
     // Update the jump table
     updateBplJumpTable();
 
-    // Rectify the scheduled event
+    // Rectify the scheduled events
     agnus.scheduleBplEventForCycle(agnus.pos.h);
+    blitter.bplEventTableDidChange();
     
     // Write back the new ddf state
     ddf = state;
@@ -447,11 +449,17 @@ Sequencer::updateBplJumpTable(i16 end)
     assert(nextBplEvent[HPOS_MAX] == HPOS_MAX);
 
     u8 next = nextBplEvent[end];
-    
+    u8 free = end < HPOS_MAX ? nextFreeCycle[end + 1] : HPOS_MAX;
+
     for (isize i = end; i >= 0; i--) {
         
         nextBplEvent[i] = next;
         if (bplEvent[i]) next = (i8)i;
+
+        // Bitplane fetches and refresh cycles always block the bus
+        bool blocked = bplEventNr(bplEvent[i]) >= 0 || i == 1 || i == 3 || i == 5;
+        if (!blocked || i == HPOS_MAX) free = (u8)i;
+        nextFreeCycle[i] = free;
     }
 }
 
@@ -265,6 +265,12 @@ Amiga::getConfigItem(Option option) const
         case OPT_BRIGHTNESS:
         case OPT_CONTRAST:
         case OPT_SATURATION:
+        case OPT_TEXTURE_FORMAT:
+        case OPT_OUTPUT_RESOLUTION:
+        case OPT_VIEWPORT_CROPPING:
+        case OPT_PIPELINING:
+        case OPT_WARP_FRAME_SKIP:
+        case OPT_DIRTY_TRACKING:
             
             return denise.pixelEngine.getConfigItem(option);
             
@@ -301,6 +307,7 @@ Amiga::getConfigItem(Option option) const
         case OPT_SAMPLING_METHOD:
         case OPT_AUDVOLL:
         case OPT_AUDVOLR:
+        case OPT_WARP_AUDIO_SKIP:
             
             return paula.muxer.getConfigItem(option);
 
@@ -532,6 +539,12 @@ Amiga::configure(Option option, i64 value)
         case OPT_BRIGHTNESS:
         case OPT_CONTRAST:
         case OPT_SATURATION:
+        case OPT_TEXTURE_FORMAT:
+        case OPT_OUTPUT_RESOLUTION:
+        case OPT_VIEWPORT_CROPPING:
+        case OPT_PIPELINING:
+        case OPT_WARP_FRAME_SKIP:
+        case OPT_DIRTY_TRACKING:
             
             denise.pixelEngine.setConfigItem(option, value);
             break;
@@ -609,6 +622,7 @@ Amiga::configure(Option option, i64 value)
         case OPT_FILTER_ACTIVATION:
         case OPT_AUDVOLL:
         case OPT_AUDVOLR:
+        case OPT_WARP_AUDIO_SKIP:
             
             paula.muxer.setConfigItem(option, value);
             break;
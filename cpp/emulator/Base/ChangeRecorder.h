@@ -11,6 +11,8 @@
 
 #include "RingBuffer.h"
 #include "AgnusTypes.h"
+#include <algorithm>
+#include <vector>
 
 namespace vamiga {
 
@@ -173,6 +175,136 @@ struct RegChangeRecorder : public util::SortedRingBuffer<RegChange, capacity>
     }
 };
 
+/* Register change wheel
+ *
+ * A timing wheel storing the pending register changes of Agnus. The wheel
+ * consists of a fixed number of buckets, each of which collects all changes
+ * scheduled for a particular DMA cycle. Because register changes are delayed
+ * by a few DMA cycles only, a change can be inserted in constant time by
+ * appending it to the bucket of its trigger cycle. Changes that don't fit
+ * into the wheel, either because the bucket is full or because it is still
+ * occupied by another cycle, are stored in a sorted backup buffer. The backup
+ * buffer grows on demand which means that no change is ever dropped.
+ */
+template <isize slots, isize depth>
+struct RegChangeWheel
+{
+    static_assert((slots & (slots - 1)) == 0);
+
+    // Bucket storage
+    RegChange changes[slots * depth];
+
+    // Trigger cycle of each bucket
+    Cycle cycles[slots];
+
+    // Number of stored and processed changes in each bucket
+    u8 count[slots];
+    u8 rpos[slots];
+
+    // Changes that didn't fit into the wheel (sorted by trigger cycle)
+    std::vector<Cycle> overflowCycles;
+    std::vector<RegChange> overflow;
+
+    // Trigger cycle of the next change (0 = wheel is empty)
+    Cycle next;
+
+    template <class W>
+    void operator<<(W& worker)
+    {
+        worker >> changes << cycles << count << rpos << overflowCycles >> overflow << next;
+    }
+
+    static isize bucket(Cycle cycle) { return AS_DMA_CYCLES(cycle) & (slots - 1); }
+
+    bool isEmpty() const { return next == 0; }
+    Cycle trigger() const { return next ? next : NEVER; }
+
+    // Inserts a change and returns false if it had to go to the backup buffer
+    bool insert(Cycle cycle, RegChange change)
+    {
+        auto b = bucket(cycle);
+        bool fits = count[b] == 0 || (cycles[b] == cycle && count[b] < depth);
+
+        // Preserve the insertion order of changes with the same trigger cycle
+        if (fits && !overflow.empty()) {
+
+            for (auto c : overflowCycles) {
+                if (c == cycle) { fits = false; break; }
+            }
+        }
+
+        if (fits) {
+
+            cycles[b] = cycle;
+            changes[b * depth + count[b]++] = change;
+
+        } else {
+
+            auto it = std::upper_bound(overflowCycles.begin(), overflowCycles.end(), cycle);
+            overflow.insert(overflow.begin() + (it - overflowCycles.begin()), change);
+            overflowCycles.insert(it, cycle);
+        }
+
+        if (!next || cycle < next) next = cycle;
+        return fits;
+    }
+
+    // Removes and returns the next change in chronological order
+    RegChange read()
+    {
+        RegChange result;
+        readBatch(&result, 1);
+        return result;
+    }
+
+    // Removes up to 'max' changes that are due in the next trigger cycle
+    isize readBatch(RegChange *batch, isize max)
+    {
+        assert(!isEmpty());
+        assert(max > 0);
+
+        isize n = 0;
+        auto b = bucket(next);
+        [[maybe_unused]] auto prev = next;
+
+        // Collect the changes from the bucket
+        if (count[b] && cycles[b] == next) {
+
+            while (n < max && rpos[b] < count[b]) {
+                batch[n++] = changes[b * depth + rpos[b]++];
+            }
+            if (rpos[b] == count[b]) count[b] = rpos[b] = 0;
+        }
+
+        /* Collect the changes from the backup buffer. This has to be done
+         * whenever the bucket does not (or no longer) hold changes for the
+         * trigger cycle, even if it is occupied by a later cycle.
+         */
+        if (!(count[b] && cycles[b] == next)) {
+
+            isize i = 0;
+            while (n < max && i < isize(overflow.size()) && overflowCycles[i] == next) {
+                batch[n++] = overflow[i++];
+            }
+            overflow.erase(overflow.begin(), overflow.begin() + i);
+            overflowCycles.erase(overflowCycles.begin(), overflowCycles.begin() + i);
+        }
+
+        // Determine the trigger cycle of the next change
+        if (n == max && (count[b] || (!overflow.empty() && overflowCycles[0] == next))) {
+            return n;
+        }
+        next = overflow.empty() ? 0 : overflowCycles[0];
+        for (isize i = 0; i < slots; i++) {
+            if (count[i] && (!next || cycles[i] < next)) next = cycles[i];
+        }
+
+        // Each call must either make progress or advance the trigger cycle
+        assert(n > 0 || next != prev);
+        return n;
+    }
+};
+
 
 //
 // Signal change recorder
@@ -38,6 +38,12 @@ enum_long(OPT)
     OPT_BRIGHTNESS,
     OPT_CONTRAST,
     OPT_SATURATION,
+    OPT_TEXTURE_FORMAT,
+    OPT_OUTPUT_RESOLUTION,
+    OPT_VIEWPORT_CROPPING,
+    OPT_PIPELINING,
+    OPT_WARP_FRAME_SKIP,
+    OPT_DIRTY_TRACKING,
     
     // DMA Debugger
     OPT_DMA_DEBUG_ENABLE,
@@ -134,6 +140,7 @@ enum_long(OPT)
     OPT_AUDVOL,
     OPT_AUDVOLL,
     OPT_AUDVOLR,
+    OPT_WARP_AUDIO_SKIP,
     
     // Expansion boards
     OPT_DIAG_BOARD,
@@ -174,6 +181,12 @@ struct OptionEnum : util::Reflection<OptionEnum, Option>
             case OPT_BRIGHTNESS:            return "BRIGHTNESS";
             case OPT_CONTRAST:              return "CONTRAST";
             case OPT_SATURATION:            return "SATURATION";
+            case OPT_TEXTURE_FORMAT:        return "TEXTURE_FORMAT";
+            case OPT_OUTPUT_RESOLUTION:     return "OUTPUT_RESOLUTION";
+            case OPT_VIEWPORT_CROPPING:     return "VIEWPORT_CROPPING";
+            case OPT_PIPELINING:            return "PIPELINING";
+            case OPT_WARP_FRAME_SKIP:       return "WARP_FRAME_SKIP";
+            case OPT_DIRTY_TRACKING:        return "DIRTY_TRACKING";
 
             case OPT_DMA_DEBUG_ENABLE:      return "DMA_DEBUG_ENABLE";
             case OPT_DMA_DEBUG_MODE:        return "DMA_DEBUG_MODE";
@@ -253,6 +266,7 @@ struct OptionEnum : util::Reflection<OptionEnum, Option>
             case OPT_AUDVOL:                return "AUDVOL";
             case OPT_AUDVOLL:               return "AUDVOLL";
             case OPT_AUDVOLR:               return "AUDVOLR";
+            case OPT_WARP_AUDIO_SKIP:       return "WARP_AUDIO_SKIP";
 
             case OPT_DIAG_BOARD:            return "DIAG_BOARD";
 
@@ -44,6 +44,12 @@ Defaults::Defaults()
     setFallback(OPT_BRIGHTNESS, 50);
     setFallback(OPT_CONTRAST, 100);
     setFallback(OPT_SATURATION, 50);
+    setFallback(OPT_TEXTURE_FORMAT, TEXFMT_RGBA8888);
+    setFallback(OPT_OUTPUT_RESOLUTION, OUTRES_FULL);
+    setFallback(OPT_VIEWPORT_CROPPING, false);
+    setFallback(OPT_PIPELINING, false);
+    setFallback(OPT_WARP_FRAME_SKIP, 1);
+    setFallback(OPT_DIRTY_TRACKING, false);
     setFallback(OPT_DMA_DEBUG_ENABLE, false);
     setFallback(OPT_DMA_DEBUG_MODE, DMA_DISPLAY_MODE_FG_LAYER);
     setFallback(OPT_DMA_DEBUG_OPACITY, 50);
@@ -127,6 +133,7 @@ Defaults::Defaults()
     setFallback(OPT_AUDVOL, { 0, 1, 2, 3 }, 100);
     setFallback(OPT_AUDVOLL, 50);
     setFallback(OPT_AUDVOLR, 50);
+    setFallback(OPT_WARP_AUDIO_SKIP, false);
     setFallback(OPT_DIAG_BOARD, false);
     setFallback(OPT_SRV_PORT, SERVER_SER, 8080);
     setFallback(OPT_SRV_PROTOCOL, SERVER_SER, SRVPROT_DEFAULT);
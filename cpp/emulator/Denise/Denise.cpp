@@ -11,8 +11,9 @@
 #include "Denise.h"
 #include "Agnus.h"
 #include "Amiga.h"
+#include "Checksum.h"
 #include "IOUtils.h"
-#include "SSEUtils.h"
+#include "SIMDUtils.h"
 
 namespace vamiga {
 
@@ -25,6 +26,18 @@ Denise::Denise(Amiga& ref) : SubComponent(ref)
     };
 }
 
+void
+Denise::_initialize()
+{
+    CoreComponent::_initialize();
+
+    // Verify the vectorized planar to chunky conversion once
+    if constexpr (BPL_DEBUG) {
+
+        if (!util::checkTranspose()) fatal("transpose() is broken\n");
+    }
+}
+
 void
 Denise::_reset(bool hard)
 {
@@ -34,6 +47,7 @@ Denise::_reset(bool hard)
     std::memset(iBuffer, 0, sizeof(iBuffer));
     std::memset(mBuffer, 0, sizeof(mBuffer));
     std::memset(zBuffer, 0, sizeof(zBuffer));
+    drawnSprites = 0;
 }
 
 void
@@ -189,39 +203,36 @@ Denise::updateShiftRegistersEven()
 void
 Denise::extractSlices(u8 slices[16])
 {
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[0] & mask) << 0) |
-                          (!!(shiftReg[1] & mask) << 1) |
-                          (!!(shiftReg[2] & mask) << 2) |
-                          (!!(shiftReg[3] & mask) << 3) |
-                          (!!(shiftReg[4] & mask) << 4) |
-                          (!!(shiftReg[5] & mask) << 5) );
+    util::transpose<0b111111>(shiftReg, slices);
+
+    if constexpr (BPL_DEBUG) {
+
+        u8 check[16]; util::transposeScalar(shiftReg, check, 0b111111);
+        assert(std::memcmp(slices, check, 16) == 0);
     }
 }
 
 void
 Denise::extractSlicesOdd(u8 slices[16])
 {
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[0] & mask) << 0) |
-                          (!!(shiftReg[2] & mask) << 2) |
-                          (!!(shiftReg[4] & mask) << 4) );
+    util::transpose<0b010101>(shiftReg, slices);
+
+    if constexpr (BPL_DEBUG) {
+
+        u8 check[16]; util::transposeScalar(shiftReg, check, 0b010101);
+        assert(std::memcmp(slices, check, 16) == 0);
     }
 }
 
 void
 Denise::extractSlicesEven(u8 slices[16])
 {
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[1] & mask) << 1) |
-                          (!!(shiftReg[3] & mask) << 3) |
-                          (!!(shiftReg[5] & mask) << 5) );
+    util::transpose<0b101010>(shiftReg, slices);
+
+    if constexpr (BPL_DEBUG) {
+
+        u8 check[16]; util::transposeScalar(shiftReg, check, 0b101010);
+        assert(std::memcmp(slices, check, 16) == 0);
     }
 }
 
@@ -527,6 +538,9 @@ Denise::translate()
         }
     }
     
+    // The z buffer is rebuilt from scratch
+    drawnSprites = 0;
+
     // Start with the playfield state as it was at the beginning of the line
     PFState state;
     state.zpf1 = zPF1(initialBplcon2);
@@ -582,6 +596,36 @@ Denise::translate()
 void
 Denise::translateSPF(Pixel from, Pixel to, PFState &state)
 {
+    updateSPFTable(state);
+    translate(from, to, spfTable);
+}
+
+void
+Denise::translateDPF(Pixel from, Pixel to, PFState &state)
+{
+    updateDPFTable(state);
+    translate(from, to, dpfTable);
+}
+
+void
+Denise::translate(Pixel from, Pixel to, const PFTable &table)
+{
+    for (Pixel i = from; i < to; i++) {
+
+        u8 s = bBuffer[i];
+
+        assert(PixelEngine::isPaletteIndex(s));
+        iBuffer[i] = mBuffer[i] = table.index[s];
+        zBuffer[i] = table.depth[s];
+    }
+}
+
+void
+Denise::updateSPFTable(const PFState &state)
+{
+    u64 key = u64(state.zpf2) << 1 | state.ham;
+    if (spfTable.key == key) return;
+
     /* Check for invalid bitplane modes. If the priority of the second bitplane
      * is set to an invalid value (> 4), Denise ignores the data from the first
      * four bitplanes whereever the fifth bitplane is set to 1. Some demos such
@@ -591,76 +635,63 @@ Denise::translateSPF(Pixel from, Pixel to, PFState &state)
      * Relevant tests in the vAmigaTS test suite:
      * Denise/BPLCON0/invprio0 to Denise/BPLCON0/invprio3
      */
-    
-    if (!state.zpf2 && !state.ham) {
-        
-        for (Pixel i = from; i < to; i++) {
+    bool invalid = !state.zpf2 && !state.ham;
 
-            u8 s = bBuffer[i];
+    for (u8 s = 0; s < 64; s++) {
 
-            assert(PixelEngine::isPaletteIndex(s));
-            iBuffer[i] = mBuffer[i] = (s & 0x10) ? (s & 0x30) : s;
-            zBuffer[i] = 0;
+        if (invalid) {
+
+            spfTable.index[s] = (s & 0x10) ? (s & 0x30) : s;
+            spfTable.depth[s] = 0;
+
+        } else {
+
+            spfTable.index[s] = s;
+            spfTable.depth[s] = s ? state.zpf2 : 0;
         }
-        return;
-    }
-    
-    // Translate the usual way
-    for (Pixel i = from; i < to; i++) {
-        
-        u8 s = bBuffer[i];
-        
-        assert(PixelEngine::isPaletteIndex(s));
-        iBuffer[i] = mBuffer[i] = s;
-        zBuffer[i] = s ? state.zpf2 : 0;
     }
+    spfTable.key = key;
 }
 
 void
-Denise::translateDPF(Pixel from, Pixel to, PFState &state)
+Denise::updateDPFTable(const PFState &state)
 {
-    if (state.prio) {
-        translateDPF <true> (from, to, state);
-    } else {
-        translateDPF <false> (from, to, state);
-    }
-}
+    u64 key = u64(state.zpf1) << 17 | u64(state.zpf2) << 1 | state.prio;
+    if (dpfTable.key == key) return;
 
-template <bool prio> void
-Denise::translateDPF(Pixel from, Pixel to, PFState &state)
-{
     /* If the priority of a playfield is set to an illegal value (zpf1 or
      * zpf2 will be 0 in that case), all pixels are drawn transparent.
      */
     u8 mask1 = state.zpf1 ? 0b1111 : 0b0000;
     u8 mask2 = state.zpf2 ? 0b1111 : 0b0000;
 
-    for (Pixel i = from; i < to; i++) {
-
-        u8 s = bBuffer[i];
+    for (u8 s = 0; s < 64; s++) {
 
         // Determine color indices for both playfields
         u8 index1 = (((s & 1) >> 0) | ((s & 4) >> 1) | ((s & 16) >> 2));
         u8 index2 = (((s & 2) >> 1) | ((s & 8) >> 2) | ((s & 32) >> 3));
 
+        u8 &index = dpfTable.index[s];
+        u16 &depth = dpfTable.depth[s];
+
         if (index1) {
             
             if (index2) {
 
                 // PF1 is solid, PF2 is solid
-                if (prio) {
-                    iBuffer[i] = mBuffer[i] = (index2 | 0b1000) & mask2;
-                    zBuffer[i] = state.zpf2 | Z_DPF21;
+                if (state.prio) {
+                    index = (index2 | 0b1000) & mask2;
+                    depth = state.zpf2 | Z_DPF21;
                 } else {
-                    iBuffer[i] = mBuffer[i] = index1 & mask1;
-                    zBuffer[i] = state.zpf1 | Z_DPF12;
+                    index = index1 & mask1;
+                    depth = state.zpf1 | Z_DPF12;
                 }
 
             } else {
 
                 // PF1 is solid, PF2 is transparent
-                iBuffer[i] = mBuffer[i] = index1 & mask1;
-                zBuffer[i] = state.zpf1 | Z_DPF1;
+                index = index1 & mask1;
+                depth = state.zpf1 | Z_DPF1;
             }
 
         } else {
@@ -668,17 +699,18 @@ Denise::translateDPF(Pixel from, Pixel to, PFState &state)
             if (index2) {
 
                 // PF1 is transparent, PF2 is solid
-                iBuffer[i] = mBuffer[i] = (index2 | 0b1000) & mask2;
-                zBuffer[i] = state.zpf2 | Z_DPF2;
+                index = (index2 | 0b1000) & mask2;
+                depth = state.zpf2 | Z_DPF2;
 
             } else {
 
                 // PF1 is transparent, PF2 is transparent
-                iBuffer[i] = mBuffer[i] = 0;
-                zBuffer[i] = Z_DPF;
+                index = 0;
+                depth = Z_DPF;
             }
         }
     }
+    dpfTable.key = key;
 }
 
 void
@@ -882,41 +914,46 @@ Denise::drawSpritePair(Pixel hstrt, Pixel hstop, Pixel strt1, Pixel strt2)
     bool armed2 = GET_BIT(armed, sprite2);
 
     bool attached = GET_BIT(sprctl[sprite2], 7);
-    Pixel offset = R == SHRES ? 1 : 2;
+    constexpr Pixel offset = R == SHRES ? 1 : 2;
+
+    /* The shift registers are loaded if the pixel position matches the start
+     * position of an armed sprite. Between two loads, the pixels are drawn in
+     * spans of up to 16 pixels and empty stretches are skipped entirely.
+     */
+    auto loadPos = [&](Pixel strt, bool armed) {
+        bool hit = armed && strt >= hstrt && strt < hstop && (strt - hstrt) % offset == 0;
+        return hit ? strt : hstop;
+    };
+    Pixel load1 = loadPos(strt1, armed1);
+    Pixel load2 = loadPos(strt2, armed2);
 
-    for (Pixel hpos = hstrt; hpos < hstop; hpos += offset) {
+    for (Pixel hpos = hstrt; hpos < hstop; ) {
+
+        // Skip to the next load if all shift registers are empty
+        if (!(ssra[sprite1] | ssrb[sprite1] | ssra[sprite2] | ssrb[sprite2])) {
+
+            hpos = std::min(load1, load2);
+            if (hpos >= hstop) break;
+        }
+        if (hpos == load1) {
 
-        if (hpos == strt1 && armed1) {
-            
             ssra[sprite1] = sprdata[sprite1];
             ssrb[sprite1] = sprdatb[sprite1];
+            load1 = hstop;
         }
-        if (hpos == strt2 && armed2) {
-            
+        if (hpos == load2) {
+
             ssra[sprite2] = sprdata[sprite2];
             ssrb[sprite2] = sprdatb[sprite2];
+            load2 = hstop;
         }
 
-        if (ssra[sprite1] | ssrb[sprite1] | ssra[sprite2] | ssrb[sprite2]) {
-            
-            if (hpos >= spriteClipBegin && hpos < spriteClipEnd) {
+        // Draw all pixels up to the next load
+        Pixel end = std::min({ hstop, load1, load2, hpos + 16 * offset });
+        isize count = (end - hpos + offset - 1) / offset;
 
-                if (attached) {
-                    
-                    drawAttachedSpritePixelPair <sprite2,R> (hpos);
-                    
-                } else {
-                    
-                    drawSpritePixel <sprite1,R> (hpos);
-                    drawSpritePixel <sprite2,R> (hpos);
-                }
-            }
-            
-            ssra[sprite1] = (u16)(ssra[sprite1] << 1);
-            ssrb[sprite1] = (u16)(ssrb[sprite1] << 1);
-            ssra[sprite2] = (u16)(ssra[sprite2] << 1);
-            ssrb[sprite2] = (u16)(ssrb[sprite2] << 1);
-        }
+        drawSpriteSpan <pair,R> (hpos, count, attached);
+        hpos += count * offset;
     }
 
     // Perform collision checks (if enabled)
@@ -932,61 +969,109 @@ Denise::drawSpritePair(Pixel hstrt, Pixel hstop, Pixel strt1, Pixel strt2)
     }
 }
 
-template <isize x, Resolution R> void
-Denise::drawSpritePixel(Pixel hpos)
+template <isize pair, Resolution R> void
+Denise::drawSpriteSpan(Pixel hpos, isize count, bool attached)
 {
-    assert(hpos >= spriteClipBegin && hpos < spriteClipEnd);
+    constexpr isize sprite1 = 2 * pair;
+    constexpr isize sprite2 = 2 * pair + 1;
+    constexpr Pixel offset = R == SHRES ? 1 : 2;
 
-    u8 a = (ssra[x] >> 15);
-    u8 b = (ssrb[x] >> 14) & 2;
-    u8 col = a | b;
+    assert(count >= 1 && count <= 16);
 
-    if (col) {
+    u16 a1 = ssra[sprite1], b1 = ssrb[sprite1];
+    u16 a2 = ssra[sprite2], b2 = ssrb[sprite2];
 
-        u16 z = Z_SP[x];
-        u8 base = 16 + 2 * (x & 6);
+    // Bit i of the shift registers (counted from the left) goes to pixel i
+    u16 span = u16(0xFFFF << (16 - count));
 
-        if constexpr (R == SHRES) {
+    if (attached) {
 
-            if (z > zBuffer[hpos]) mBuffer[hpos] = base | col;
-            zBuffer[hpos] |= z;
+        for (u16 mask = (a1 | b1 | a2 | b2) & span; mask; mask &= mask - 1) {
 
-        } else {
+            isize bit = std::countr_zero(mask);
+            Pixel pos = hpos + (15 - bit) * offset;
+
+            if (pos >= spriteClipBegin && pos < spriteClipEnd) {
+
+                u8 col = u8((a1 >> bit & 1) | (b1 >> bit & 1) << 1 |
+                            (a2 >> bit & 1) << 2 | (b2 >> bit & 1) << 3);
+                drawAttachedSpritePixelPair <sprite2,R> (pos, col);
+            }
+        }
+
+    } else {
+
+        for (u16 mask = (a1 | b1) & span; mask; mask &= mask - 1) {
 
-            if (z > zBuffer[hpos]) mBuffer[hpos] = base | col;
-            if (z > zBuffer[hpos + 1]) mBuffer[hpos + 1] = base | col;
-            zBuffer[hpos] |= z;
-            zBuffer[hpos + 1] |= z;
+            isize bit = std::countr_zero(mask);
+            Pixel pos = hpos + (15 - bit) * offset;
+
+            if (pos >= spriteClipBegin && pos < spriteClipEnd) {
+                drawSpritePixel <sprite1,R> (pos, u8((a1 >> bit & 1) | (b1 >> bit & 1) << 1));
+            }
         }
+        for (u16 mask = (a2 | b2) & span; mask; mask &= mask - 1) {
+
+            isize bit = std::countr_zero(mask);
+            Pixel pos = hpos + (15 - bit) * offset;
+
+            if (pos >= spriteClipBegin && pos < spriteClipEnd) {
+                drawSpritePixel <sprite2,R> (pos, u8((a2 >> bit & 1) | (b2 >> bit & 1) << 1));
+            }
+        }
+    }
+
+    ssra[sprite1] = u16(u32(a1) << count);
+    ssrb[sprite1] = u16(u32(b1) << count);
+    ssra[sprite2] = u16(u32(a2) << count);
+    ssrb[sprite2] = u16(u32(b2) << count);
+}
+
+template <isize x, Resolution R> void
+Denise::drawSpritePixel(Pixel hpos, u8 col)
+{
+    assert(hpos >= spriteClipBegin && hpos < spriteClipEnd);
+    assert(col);
+
+    u16 z = Z_SP[x];
+    u8 base = 16 + 2 * (x & 6);
+
+    drawnSprites |= 1 << x;
+
+    if constexpr (R == SHRES) {
+
+        if (z > zBuffer[hpos]) mBuffer[hpos] = base | col;
+        zBuffer[hpos] |= z;
+
+    } else {
+
+        if (z > zBuffer[hpos]) mBuffer[hpos] = base | col;
+        if (z > zBuffer[hpos + 1]) mBuffer[hpos + 1] = base | col;
+        zBuffer[hpos] |= z;
+        zBuffer[hpos + 1] |= z;
     }
 }
 
 template <isize x, Resolution R> void
-Denise::drawAttachedSpritePixelPair(Pixel hpos)
+Denise::drawAttachedSpritePixelPair(Pixel hpos, u8 col)
 {
     assert(IS_ODD(x));
     assert(hpos >= spriteClipBegin && hpos < spriteClipEnd);
+    assert(col);
 
-    u8 col =
-    ((ssra[x-1] >> 15) & 0b0001) |
-    ((ssrb[x-1] >> 14) & 0b0010) |
-    ((ssra[x]   >> 13) & 0b0100) |
-    ((ssrb[x]   >> 12) & 0b1000) ;
-    
-    if (col) {
+    u16 z = Z_SP[x];
 
-        u16 z = Z_SP[x];
+    drawnSprites |= 1 << x;
 
-        if (z > zBuffer[hpos]) {
-            
-            mBuffer[hpos] = 0b10000 | col;
-            zBuffer[hpos] |= z;
-        }
-        if (z > zBuffer[hpos+1]) {
-            
-            mBuffer[hpos+1] = 0b10000 | col;
-            zBuffer[hpos+1] |= z;
-        }
+    if (z > zBuffer[hpos]) {
+
+        mBuffer[hpos] = 0b10000 | col;
+        zBuffer[hpos] |= z;
+    }
+    if (z > zBuffer[hpos+1]) {
+
+        mBuffer[hpos+1] = 0b10000 | col;
+        zBuffer[hpos+1] |= z;
     }
 }
 
@@ -1005,6 +1090,12 @@ Denise::updateBorderColor()
 
 void
 Denise::drawBorder()
+{
+    drawBorder(0, isizeof(bBuffer));
+}
+
+void
+Denise::drawBorder(Pixel from, Pixel to)
 {
     /* The following cases need to be distinguished:
      *
@@ -1031,7 +1122,7 @@ Denise::drawBorder()
     if (!flop && !on) {
 
         // Draw blank line (2)
-        for (Pixel i = 0; i < HPIXELS; i++) {
+        for (Pixel i = from; i < std::min(to, Pixel(HPIXELS)); i++) {
             bBuffer[i] = iBuffer[i] = mBuffer[i] = borderColor;
         }
 
@@ -1043,7 +1134,7 @@ Denise::drawBorder()
 
             // Draw left border (4,5)
             auto end = std::min(2 * hflopOnPrev - hblank, isize(HPIXELS + 1));
-            for (isize i = 0; i < end; i++) {
+            for (isize i = from; i < std::min(end, to); i++) {
                 bBuffer[i] = iBuffer[i] = mBuffer[i] = borderColor;
             }
         }
@@ -1052,7 +1143,7 @@ Denise::drawBorder()
 
             // Draw right border (3,4)
             auto start = std::max(2 * hflopOffPrev - hblank, isize(0));
-            for (isize i = start; i < HPIXELS; i++) {
+            for (isize i = std::max(start, from); i < std::min(to, Pixel(HPIXELS)); i++) {
                 bBuffer[i] = iBuffer[i] = mBuffer[i] = borderColor;
             }
         }
@@ -1065,6 +1156,16 @@ Denise::checkS2SCollisions(Pixel start, Pixel end)
     // For odd sprites, only proceed if collision detection is enabled
     if constexpr (IS_ODD(x)) if (!GET_BIT(clxcon, 12 + (x/2))) return;
 
+    // Only proceed if another sprite has been drawn, too
+    if (!GET_BIT(drawnSprites, x) || !(drawnSprites & ~(1 << x))) return;
+
+    // Quick-exit if all collision bits are already set
+    if ((clxdat & 0x7E00) == 0x7E00) return;
+
+    // Stay inside the pixel buffers
+    start = std::max(start, Pixel(0));
+    end = std::min(end, Pixel(isizeof(mBuffer) - 1));
+
     // Set up the sprite comparison masks
     u16 comp01 = Z_SP0 | (GET_BIT(clxcon, 12) ? Z_SP1 : 0);
     u16 comp23 = Z_SP2 | (GET_BIT(clxcon, 13) ? Z_SP3 : 0);
@@ -1107,7 +1208,17 @@ Denise::checkS2PCollisions(Pixel start, Pixel end)
 {
     // For the odd sprites, only proceed if collision detection is enabled
     if constexpr (IS_ODD(x)) if (!ensp<x>()) return;
-    
+
+    // Only proceed if the sprite has been drawn
+    if (!GET_BIT(drawnSprites, x)) return;
+
+    // Quick-exit if both collision bits are already set
+    if (GET_BIT(clxdat, 5 + (x / 2)) && GET_BIT(clxdat, 1 + (x / 2))) return;
+
+    // Stay inside the pixel buffers
+    start = std::max(start, Pixel(0));
+    end = std::min(end, Pixel(isizeof(mBuffer) - 1));
+
     u8 enabled1 = enbp1();
     u8 enabled2 = enbp2();
     u8 compare1 = mvbp1() & enabled1;
@@ -1175,6 +1286,114 @@ Denise::checkP2PCollisions()
     }
 }
 
+bool
+Denise::canFuse() const
+{
+    if constexpr (NO_FUSED_LINES) return false;
+
+    // Sprites are drawn over the whole line
+    if (wasArmed) return false;
+
+    // Mid-line register changes are handled by the staged pipeline
+    if (!conChanges.isEmpty() || !pixelEngine.colChanges.isEmpty()) return false;
+
+    // HAM pixels depend on the pixels on the left
+    if (pixelEngine.hamMode || pixelEngine.shresMode) return false;
+
+    // Hidden bitplanes and layers are handled by the staged pipeline
+    if (config.hiddenBitplanes || config.hiddenLayers) return false;
+
+    // In pipelined mode, the staged pipeline hands the line over
+    if (pipelining()) return false;
+
+    return true;
+}
+
+bool
+Denise::hasOverlays() const
+{
+    // Hidden layers and DMA debugger overlays are drawn on the colorized line
+    return config.hiddenLayers || dmaDebugger.getConfig().enabled;
+}
+
+bool
+Denise::pipelining() const
+{
+    if (hasOverlays()) return false;
+
+    return pixelEngine.getConfig().pipelining;
+}
+
+void
+Denise::drawFused(isize vpos)
+{
+    // Number of pixels processed in one go
+    constexpr isize chunk = 128;
+
+    // Start with the playfield state as it was at the beginning of the line
+    PFState state;
+    state.zpf1 = zPF1(initialBplcon2);
+    state.zpf2 = zPF2(initialBplcon2);
+    state.prio = pf2pri(initialBplcon2);
+    state.ham = ham(initialBplcon0);
+    bool dual = dbplf(initialBplcon0);
+
+    // The z buffer is rebuilt from scratch
+    drawnSprites = 0;
+
+    auto *dst = pixelEngine.workingPtr(vpos);
+
+    for (Pixel from = 0; from < isizeof(bBuffer); from += chunk) {
+
+        Pixel to = std::min(from + chunk, Pixel(isizeof(bBuffer)));
+
+        // Translate, draw the border, and colorize while the chunk is hot
+        if (dual) {
+            translateDPF(from, to, state);
+        } else {
+            translateSPF(from, to, state);
+        }
+        drawBorder(from, to);
+        if (from < HPIXELS) pixelEngine.colorize(vpos, from, std::min(to, Pixel(HPIXELS)));
+    }
+
+    pixelEngine.wipeHBlank(dst);
+}
+
+u64
+Denise::fingerprint()
+{
+    // Lines with sprites or hidden graphics layers are not covered
+    if (wasArmed || config.hiddenBitplanes || config.hiddenLayers) return 0;
+
+    auto &colChanges = pixelEngine.colChanges;
+
+    u64 state[4] = {
+
+        u64(initialBplcon0) | u64(initialBplcon2) << 16 | u64(borderColor) << 32 |
+        u64(hflopPrev) << 40 | u64(pixelEngine.hamMode) << 41 |
+        u64(pixelEngine.shresMode) << 42 | u64(agnus.res) << 48,
+        u64(hflopOnPrev) | u64(hflopOffPrev) << 32,
+        u64(agnus.pos.hLatched) | u64(conChanges.count()) << 16 | u64(colChanges.count()) << 32,
+        pixelEngine.getPaletteHash()
+    };
+
+    auto hash = util::fnv64((const u64 *)bBuffer, isizeof(bBuffer) / 8) ^ util::fnv64(state, 4);
+
+    // Mix in all recorded register changes
+    auto mix = [&](i64 key, const RegChange &change) {
+        hash = (hash ^ (u64(key) << 32 | u64(change.addr & 0xFFFF) << 16 | change.value)) * 0x100000001B3;
+    };
+    for (isize i = 0, end = conChanges.end(); i < end; i++) {
+        mix(conChanges.keys[i], conChanges.elements[i]);
+    }
+    for (isize i = 0, end = colChanges.end(); i < end; i++) {
+        mix(colChanges.keys[i], colChanges.elements[i]);
+    }
+
+    return hash;
+}
+
 void
 Denise::vsyncHandler()
 {
@@ -1193,8 +1412,58 @@ Denise::hsyncHandler(isize vpos)
     // Finish the current line
     //
 
+    /* Reuse the line of the previous frame if it has been drawn from the same
+     * data. The last line of a frame (drawn when v is 0) is always translated.
+     * The lines in the VBLANK area don't translate, so line 25 draws its
+     * sprites on the z buffer left behind by the last translated line. If the
+     * last line of a frame was reused, this z buffer would be a stale one.
+     */
+    bool skipped = vpos >= 26 && agnus.pos.v && pixelEngine.isSkipping();
+    bool reused = !skipped && vpos >= 26 && agnus.pos.v && pixelEngine.reuseRow(vpos, fingerprint());
+
+    // The last line is drawn in any case, but it keeps its fingerprint
+    if (vpos >= 26 && !agnus.pos.v) pixelEngine.assignFingerprint(vpos, fingerprint());
+
     // Check if we are below the VBLANK area
-    if (vpos >= 26) {
+    if (skipped) {
+
+        // The z buffer is needed for sprite collisions (translate() wipes hidden bitplanes)
+        if (wasArmed || config.hiddenBitplanes) translate();
+
+        // Draw sprites to keep the collision bits up to date
+        drawSprites();
+
+        // Perform playfield-playfield collision check (if enabled)
+        if (config.clxPlfPlf) checkP2PCollisions();
+
+        // Apply the register changes without drawing anything
+        pixelEngine.applyRegisterChanges();
+        conChanges.clear();
+
+    } else if (reused) {
+
+        // Replay the sprite register changes (no sprite is armed)
+        drawSprites();
+
+        // Perform playfield-playfield collision check (if enabled)
+        if (config.clxPlfPlf) checkP2PCollisions();
+
+        // Apply the register changes without drawing anything
+        pixelEngine.applyRegisterChanges();
+        conChanges.clear();
+
+    } else if (vpos >= 26 && canFuse()) {
+
+        // Replay the sprite register changes (no sprite is armed)
+        drawSprites();
+
+        // Perform playfield-playfield collision check (if enabled)
+        if (config.clxPlfPlf) checkP2PCollisions();
+
+        // Run all remaining stages chunk by chunk
+        drawFused(vpos);
+
+    } else if (vpos >= 26) {
 
         // Translate bitplane data to color register indices
         translate();
@@ -1208,18 +1477,26 @@ Denise::hsyncHandler(isize vpos)
         // Draw horizontal border
         drawBorder();
 
-        // Synthesize RGBA values and write the result into the frame buffer
-        pixelEngine.colorize(vpos);
+        if (pipelining()) {
 
-        // Remove certain graphics layers if requested
-        if (config.hiddenLayers) {
-            pixelEngine.hide(vpos, config.hiddenLayers, config.hiddenLayerAlpha);
+            // Let the colorizer thread synthesize the RGBA values
+            pixelEngine.colorizeAsync(vpos);
+
+        } else {
+
+            // Synthesize RGBA values and write the result into the frame buffer
+            pixelEngine.colorize(vpos);
+
+            // Remove certain graphics layers if requested
+            if (config.hiddenLayers) {
+                pixelEngine.hide(vpos, config.hiddenLayers, config.hiddenLayerAlpha);
+            }
         }
         
     } else {
         
         drawSprites();
-        pixelEngine.endOfVBlankLine();
+        pixelEngine.applyRegisterChanges();
         conChanges.clear();
     }
 
@@ -1231,7 +1508,9 @@ Denise::hsyncHandler(isize vpos)
     assert(sprChanges[3].isEmpty());
 
     // Clear the last pixel if this line was a short line
-    if (agnus.pos.hLatched == HPOS_CNT_PAL) pixelEngine.getWorkingBuffer().clear(vpos, HPOS_MAX);
+    if (agnus.pos.hLatched == HPOS_CNT_PAL && !pixelEngine.isQueued(vpos)) {
+        pixelEngine.getWorkingBuffer().clear(vpos, HPOS_MAX);
+    }
 
     // Clear the bBuffer
     std::memset(bBuffer, 0, sizeof(bBuffer));
@@ -1278,7 +1557,5 @@ template void Denise::drawOdd<true>(Pixel offset);
 template void Denise::drawEven<false>(Pixel offset);
 template void Denise::drawEven<true>(Pixel offset);
 
-template void Denise::translateDPF<true>(Pixel from, Pixel to, PFState &state);
-template void Denise::translateDPF<false>(Pixel from, Pixel to, PFState &state);
 
 }
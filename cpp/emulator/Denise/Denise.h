@@ -138,7 +138,7 @@ public:
      * written to. This is emulated in function fillShiftRegister().
      *
      * Note: The upper two array elements are dummy elements. We need them in
-     * order to pass the array as parameter to function transposeSSE().
+     * order to pass the array as parameter to function util::transpose().
      */
     alignas(16) u16 shiftReg[8];
 
@@ -191,6 +191,12 @@ public:
      */
     u8 wasArmed;
 
+    /* Remembers the sprites that have put a pixel into the z buffer since it
+     * has been rebuilt by translate(). The collision checks are skipped for
+     * all other sprites, because they can't produce a hit.
+     */
+    u8 drawnSprites;
+
     /* Sprite clipping window
      *
      * The clipping window determines where sprite pixels can be drawn.
@@ -264,11 +270,22 @@ public:
      *  SPx : Set if the pixel is solid in sprite x.
      *  _x_ : Playfield priority derived from the current value in BPLCON2.
      */
-    u8 bBuffer[HPIXELS + (4 * 16) + 8];
+    alignas(8) u8 bBuffer[HPIXELS + (4 * 16) + 8];
     u8 iBuffer[HPIXELS + (4 * 16) + 8];
     u8 mBuffer[HPIXELS + (4 * 16) + 8];
     u16 zBuffer[HPIXELS + (4 * 16) + 8];
 
+    /* Playfield lookup tables
+     *
+     * The translation functions map the bitplane data with the help of these
+     * tables. They are indexed by the 6-bit bBuffer value and provide the
+     * corresponding color index and pixel depth. A table is only rebuilt if
+     * the playfield state changes, which is rarely the case.
+     */
+    struct PFTable { u8 index[64]; u16 depth[64]; u64 key = UINT64_MAX; };
+    PFTable spfTable;
+    PFTable dpfTable;
+
     static constexpr u16 Z_0   = 0b10000000'00000000;
     static constexpr u16 Z_SP0 = 0b01000000'00000000;
     static constexpr u16 Z_SP1 = 0b00100000'00000000;
@@ -333,6 +350,7 @@ private:
     
 private:
     
+    void _initialize() override;
     void _reset(bool hard) override;
     void _inspect() const override;
     
@@ -495,8 +513,12 @@ private:
     // Called by translate() in dual-playfield mode
     void translateDPF(Pixel from, Pixel to, PFState &state);
     
-    // Called by translateDPF(...)
-    template <bool prio> void translateDPF(Pixel from, Pixel to, PFState &state);
+    // Called by translateSPF(...) and translateDPF(...)
+    void translate(Pixel from, Pixel to, const PFTable &table);
+
+    // Rebuilds the playfield lookup tables if the state has changed
+    void updateSPFTable(const PFState &state);
+    void updateDPFTable(const PFState &state);
 
     
     //
@@ -510,6 +532,39 @@ private:
 
     // Draws the horizontal border
     void drawBorder();
+    void drawBorder(Pixel from, Pixel to);
+
+    
+    //
+    // Running the fused pipeline
+    //
+
+public:
+
+    // Checks whether colorized lines are modified afterwards
+    bool hasOverlays() const;
+
+private:
+
+    /* Checks whether the current line can be finished by the fused pipeline.
+     * The fused pipeline translates, borders, and colorizes a line in small
+     * chunks. Hence, the intermediate buffers stay in the L1 cache. It is
+     * used for all lines without sprites, mid-line register changes, or HAM.
+     */
+    bool canFuse() const;
+
+    // Checks whether the current line is colorized by the colorizer thread
+    bool pipelining() const;
+
+    // Finishes the current line with the fused pipeline
+    void drawFused(isize vpos);
+
+    /* Computes a fingerprint of all data the current line depends on. If a
+     * line has the same fingerprint as the same line in the previous frame,
+     * the line is reused and the drawing pipeline is skipped. A fingerprint
+     * of 0 indicates that the line can't be reused.
+     */
+    u64 fingerprint();
 
     
     //
@@ -542,9 +597,13 @@ private:
     // Replays all recorded sprite register changes
     template <isize pair> void replaySpriteRegChanges();
 
+    // Draws up to 16 pixels of a sprite pair and advances the shift registers
+    template <isize pair, Resolution R> void drawSpriteSpan(Pixel hpos, isize count,
+                                                            bool attached);
+
     // Draws a single sprite pixel
-    template <isize x, Resolution R> void drawSpritePixel(Pixel hpos);
-    template <isize x, Resolution R> void drawAttachedSpritePixelPair(Pixel hpos);
+    template <isize x, Resolution R> void drawSpritePixel(Pixel hpos, u8 col);
+    template <isize x, Resolution R> void drawAttachedSpritePixelPair(Pixel hpos, u8 col);
 
     
     //
@@ -102,6 +102,7 @@ public:
     isize getSpriteHeight(isize nr) const { return latchedSpriteInfo[nr].height; }
     u16 getSpriteColor(isize nr, isize reg) const { return latchedSpriteInfo[nr].colors[reg]; }
     u64 getSpriteData(isize nr, isize line) const { return latchedSpriteData[nr][line]; }
+    const ViewPortInfo &getMaxViewPort() const { return maxViewPort; }
 
     
     //
@@ -11,11 +11,397 @@
 #include "config.h"
 #include "FrameBuffer.h"
 
+#include <algorithm>
+#include <bit>
+
 namespace vamiga {
 
 FrameBuffer::FrameBuffer()
 {
     pixels.alloc(PIXELS);
+    nr = seq = 0;
+    format = TEXFMT_RGBA8888;
+    scale = 1;
+    discardReducedRows();
+    cropX = cropY = cropWidth = cropHeight = 0;
+    repeated = false;
+    std::memset(fingerprint, 0, sizeof(fingerprint));
+    std::memset(checksum, 0, sizeof(checksum));
+    std::memset(converted, 0, sizeof(converted));
+    markAllDirty();
+}
+
+void
+FrameBuffer::markAllDirty()
+{
+    for (isize i = 0; i < isizeof(dirty) / 4; i++) dirty[i] = 0xFFFFFFFF;
+
+    dirtyBase = -1;
+    firstDirty = 0;
+    lastDirty = VPIXELS - 1;
+}
+
+void
+FrameBuffer::convert(TextureFormat format)
+{
+    // Invalidate the compact representation if the format changes
+    if (format != this->format) std::memset(converted, 0, sizeof(converted));
+
+    this->format = format;
+
+    switch (format) {
+
+        case TEXFMT_RGB565:
+        case TEXFMT_RGBA4444:
+
+            if (pixels16.empty()) pixels16.alloc(PIXELS * TPP);
+            break;
+
+        case TEXFMT_INDEXED:
+
+            if (indices.empty()) indices.alloc(PIXELS * TPP);
+            if (colors.empty()) colors.alloc(VPIXELS * 256);
+            break;
+
+        default:
+            return;
+    }
+
+    for (isize row = 0; row < VPIXELS; row++) {
+
+        // Skip rows that haven't changed since they were converted last time
+        if (converted[row] == checksum[row]) continue;
+
+        switch (format) {
+
+            case TEXFMT_RGB565:     convertRGB565(row); break;
+            case TEXFMT_RGBA4444:   convertRGBA4444(row); break;
+            case TEXFMT_INDEXED:    convertIndexed(row); break;
+
+            default:
+                break;
+        }
+        converted[row] = checksum[row];
+    }
+}
+
+void
+FrameBuffer::convertRGB565(isize row)
+{
+    auto *src = (u32 *)(pixels.ptr + row * HPIXELS);
+    auto *dst = pixels16.ptr + row * HPIXELS * TPP;
+
+    for (isize i = 0; i < HPIXELS * TPP; i++) {
+
+        u32 col = src[i];
+        u32 r = (col >> 0) & 0xF8, g = (col >> 8) & 0xFC, b = (col >> 16) & 0xF8;
+        dst[i] = u16(r << 8 | g << 3 | b >> 3);
+    }
+}
+
+void
+FrameBuffer::convertRGBA4444(isize row)
+{
+    auto *src = (u32 *)(pixels.ptr + row * HPIXELS);
+    auto *dst = pixels16.ptr + row * HPIXELS * TPP;
+
+    for (isize i = 0; i < HPIXELS * TPP; i++) {
+
+        u32 col = src[i];
+        u32 r = (col >> 0) & 0xF0, g = (col >> 8) & 0xF0, b = (col >> 16) & 0xF0;
+        dst[i] = u16(r << 8 | g << 4 | b | col >> 28);
+    }
+}
+
+void
+FrameBuffer::convertIndexed(isize row)
+{
+    auto *src = (u32 *)(pixels.ptr + row * HPIXELS);
+    auto *dst = indices.ptr + row * HPIXELS * TPP;
+    auto *palette = colors.ptr + row * 256;
+
+    auto count = convertIndexed(src, dst, palette);
+
+    if (count < 0) {
+
+        // Too many colors. Fall back to a fixed RGB332 palette
+        for (isize i = 0; i < 256; i++) {
+
+            u32 r = u32(((i >> 5) & 7) * 255 / 7);
+            u32 g = u32(((i >> 2) & 7) * 255 / 7);
+            u32 b = u32(((i >> 0) & 3) * 255 / 3);
+            palette[i] = 0xFF000000 | b << 16 | g << 8 | r;
+        }
+        for (isize i = 0; i < HPIXELS * TPP; i++) {
+
+            u32 col = src[i];
+            dst[i] = u8((col & 0xE0) | (col >> 11 & 0x1C) | (col >> 22 & 0x03));
+        }
+        count = 256;
+    }
+
+    colorCount[row] = u16(count);
+}
+
+isize
+FrameBuffer::convertIndexed(const u32 *src, u8 *dst, u32 *palette)
+{
+    // Hash table mapping colors to palette entries (0 = empty slot)
+    u16 slot[512] = { };
+    isize count = 0;
+
+    u32 last = ~src[0];
+    u8 index = 0;
+
+    for (isize i = 0; i < HPIXELS * TPP; i++) {
+
+        u32 col = src[i];
+
+        // Most pixels have the same color as their left neighbor
+        if (col != last) {
+
+            isize h = (col * 0x9E3779B1) >> 23;
+            while (slot[h] && palette[slot[h] - 1] != col) h = (h + 1) & 511;
+
+            if (!slot[h]) {
+
+                if (count == 256) return -1;
+                palette[count++] = col;
+                slot[h] = u16(count);
+            }
+            index = u8(slot[h] - 1);
+            last = col;
+        }
+        dst[i] = index;
+    }
+
+    return count;
+}
+
+void
+FrameBuffer::reduce(OutputResolution resolution)
+{
+    isize s;
+
+    switch (resolution) {
+
+        case OUTRES_HALF:       s = 2; break;
+        case OUTRES_QUARTER:    s = 4; break;
+
+        default:
+            scale = 1;
+            return;
+    }
+
+    setScale(s);
+
+    // Compute all rows that haven't been computed while drawing the frame
+    for (isize row = 0; row < VPIXELS / s; row++) {
+
+        if (reducedRow[row]) continue;
+        s == 2 ? reduce<2>(row) : reduce<4>(row);
+    }
+
+    // Start over in the next frame
+    discardReducedRows();
+}
+
+void
+FrameBuffer::accumulate(OutputResolution resolution, isize row, Pixel from, Pixel to)
+{
+    // The remaining texels are added when the row is finished
+    from = std::max(from, visibleStart);
+    to = std::min(to, visibleEnd);
+
+    if (from < to) {
+
+        switch (resolution) {
+
+            case OUTRES_HALF:       accumulate<2>(row, from, to); break;
+            case OUTRES_QUARTER:    accumulate<4>(row, from, to); break;
+
+            default:
+                return;
+        }
+        accumulated[row] = true;
+    }
+}
+
+void
+FrameBuffer::reduce(OutputResolution resolution, isize row)
+{
+    switch (resolution) {
+
+        case OUTRES_HALF:       finish<2>(row); break;
+        case OUTRES_QUARTER:    finish<4>(row); break;
+
+        default:
+            break;
+    }
+}
+
+void
+FrameBuffer::discardReducedRows()
+{
+    std::memset(reducedRow, 0, sizeof(reducedRow));
+    std::memset(accumulated, 0, sizeof(accumulated));
+    sumBlock = -1;
+    sumRows = 0;
+}
+
+void
+FrameBuffer::setScale(isize s)
+{
+    if (reduced.empty()) {
+
+        reduced.alloc((HPIXELS / 2) * (VPIXELS / 2));
+        sumRB.alloc(HPIXELS / 2);
+        sumGA.alloc(HPIXELS / 2);
+    }
+
+    // Rows computed with another scale factor are invalid
+    if (scale != s) discardReducedRows();
+
+    scale = s;
+}
+
+template <isize s> void
+FrameBuffer::reduce(isize row)
+{
+    constexpr isize width = HPIXELS / s;
+
+    // Number of texels per block and the corresponding division shift
+    constexpr isize block = s * s * TPP;
+    constexpr isize shift = std::countr_zero(u32(block));
+    static_assert(block * 255 <= 0xFFFF);
+
+    auto *src = (u32 *)(pixels.ptr + row * s * HPIXELS);
+    auto *dst = reduced.ptr + row * width;
+
+    // Channel sums of all blocks (red and blue in rb, green and alpha in ga)
+    u32 rb[width] = { };
+    u32 ga[width] = { };
+
+    for (isize i = 0; i < s; i++, src += HPIXELS * TPP) {
+
+        for (isize x = 0; x < width; x++) {
+
+            for (isize j = 0; j < s * TPP; j++) {
+
+                u32 col = src[x * s * TPP + j];
+                rb[x] += col & 0x00FF00FF;
+                ga[x] += (col >> 8) & 0x00FF00FF;
+            }
+        }
+    }
+
+    for (isize x = 0; x < width; x++) {
+
+        dst[x] = ((rb[x] >> shift) & 0x00FF00FF) | ((ga[x] >> shift) & 0x00FF00FF) << 8;
+    }
+
+    reducedRow[row] = true;
+}
+
+template <isize s> void
+FrameBuffer::accumulate(isize row, Pixel from, Pixel to)
+{
+    // Rows beyond the last complete block row are ignored
+    if (row / s >= VPIXELS / s) return;
+
+    setScale(s);
+
+    // Start over if the row belongs to another block row
+    if (sumBlock != row / s) {
+
+        sumRB.clear();
+        sumGA.clear();
+        sumBlock = row / s;
+        sumRows = 0;
+    }
+
+    auto *src = (u32 *)(pixels.ptr + row * HPIXELS);
+    auto *rb = sumRB.ptr;
+    auto *ga = sumGA.ptr;
+
+    for (Pixel x = from; x < to; x++) {
+
+        for (isize j = 0; j < TPP; j++) {
+
+            u32 col = src[x * TPP + j];
+            rb[x / s] += col & 0x00FF00FF;
+            ga[x / s] += (col >> 8) & 0x00FF00FF;
+        }
+    }
+}
+
+template <isize s> void
+FrameBuffer::finish(isize row)
+{
+    constexpr isize width = HPIXELS / s;
+    constexpr isize shift = std::countr_zero(u32(s * s * TPP));
+
+    if (row / s >= VPIXELS / s) return;
+
+    // Add all texels the colorizer hasn't added
+    if (accumulated[row]) {
+
+        accumulate<s>(row, 0, visibleStart);
+        accumulate<s>(row, visibleEnd, HPIXELS);
+
+    } else {
+
+        accumulate<s>(row, 0, HPIXELS);
+    }
+    accumulated[row] = false;
+    sumRows++;
+
+    if (row % s == s - 1) {
+
+        // Compute the block row if all pixel rows have been added
+        if (sumRows == s) {
+
+            auto *dst = reduced.ptr + sumBlock * width;
+
+            for (isize x = 0; x < width; x++) {
+
+                dst[x] =
+                ((sumRB[x] >> shift) & 0x00FF00FF) | ((sumGA[x] >> shift) & 0x00FF00FF) << 8;
+            }
+            reducedRow[sumBlock] = true;
+        }
+        sumBlock = -1;
+    }
+}
+
+void
+FrameBuffer::crop(isize x1, isize y1, isize x2, isize y2)
+{
+    x1 = std::clamp(x1, isize(0), isize(HPIXELS));
+    x2 = std::clamp(x2, isize(0), isize(HPIXELS));
+    y1 = std::clamp(y1, isize(0), isize(VPIXELS));
+    y2 = std::clamp(y2, isize(0), isize(VPIXELS));
+
+    // Don't crop if the area is empty (e.g., if the DIW never opens)
+    if (x1 >= x2 || y1 >= y2) {
+
+        cropX = cropY = cropWidth = cropHeight = 0;
+        return;
+    }
+
+    if (cropped.empty()) cropped.alloc(PIXELS);
+
+    cropX = x1;
+    cropY = y1;
+    cropWidth = x2 - x1;
+    cropHeight = y2 - y1;
+
+    auto *src = pixels.ptr + y1 * HPIXELS + x1;
+    auto *dst = cropped.ptr;
+
+    for (isize y = 0; y < cropHeight; y++, src += HPIXELS, dst += cropWidth) {
+        std::memcpy(dst, src, cropWidth * sizeof(Texel));
+    }
 }
 
 void
@@ -28,6 +414,7 @@ FrameBuffer::clear()
             ptr[col] = ((row >> 2) & 1) == ((col >> 3) & 1) ? cb1 : cb2;
         }
     }
+    std::memset(fingerprint, 0, sizeof(fingerprint));
 }
 
 void
@@ -38,6 +425,7 @@ FrameBuffer::clear(isize row)
     for (isize col = 0; col < HPIXELS; col++) {
         ptr[col] = ((row >> 2) & 1) == ((col >> 3) & 1) ? cb1 : cb2;
     }
+    fingerprint[row] = 0;
 }
 
 void
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "FrameBufferTypes.h"
+#include "PixelEngineTypes.h"
 #include "Buffer.h"
 #include "Constants.h"
 #include "Colors.h"
@@ -41,6 +42,9 @@ struct FrameBuffer {
     // Frame number
     i64 nr;
 
+    // Sequence number (counts all completed frames, used to detect drops)
+    i64 seq;
+
     // Pixel buffer
     Buffer <Texel> pixels;
 
@@ -50,8 +54,135 @@ struct FrameBuffer {
     // The long-frame bit of the previous frame
     bool prevlof;
 
+    /* Rows that differ from the previous frame with the same long-frame bit.
+     * The bitmap is computed by the PixelEngine when the frame is complete.
+     * dirtyBase is the number of the frame the rows have been compared with
+     * (-1 if there is no such frame and all rows are marked as dirty). Unless
+     * dirty row tracking is enabled or a compact texture format is selected,
+     * no rows are compared and all rows are marked as dirty.
+     */
+    u32 dirty[(VPIXELS + 31) / 32];
+    i64 dirtyBase;
+
+    // The first and the last dirty row (first > last if no row has changed)
+    isize firstDirty;
+    isize lastDirty;
+
+    /* Fingerprints of the data the rows have been drawn from. Rows with the
+     * same fingerprint have the same contents. A fingerprint of 0 marks a row
+     * that has been drawn from data that isn't covered by a fingerprint.
+     */
+    u64 fingerprint[VPIXELS];
+
+    // Indicates whether all rows have been reused from the previous frame
+    bool repeated;
+
+    // Checksums of all rows (computed by the PixelEngine with the dirty rows)
+    u64 checksum[VPIXELS];
+
+    /* Compact representation of the pixel buffer. Depending on the selected
+     * texture format, the PixelEngine converts the frame into one of the
+     * following buffers when the frame is complete:
+     *
+     *       RGB565, RGBA4444 : pixels16 (one u16 per GPU texel)
+     *                INDEXED : indices (one u8 per GPU texel) and a palette
+     *                          for each row. The palette of row r starts at
+     *                          colors[256 * r] and has colorCount[r] entries.
+     *
+     * If a row contains more than 256 different colors, it is quantized to
+     * a fixed RGB332 palette. Only rows whose checksum differs from the
+     * checksum they have been converted from are converted again.
+     */
+    TextureFormat format;
+    Buffer <u16> pixels16;
+    Buffer <u8> indices;
+    Buffer <u32> colors;
+    u16 colorCount[VPIXELS];
+    u64 converted[VPIXELS];
+
+    /* Reduced-resolution copy of the pixel buffer. If a reduced output
+     * resolution is selected, the PixelEngine box-filters the frame into this
+     * buffer. Each element is the average of a block of scale x scale pixels.
+     * The buffer is organized in rows of HPIXELS / scale elements. It contains
+     * VPIXELS / scale rows. The colorizer adds the texels of the visible area
+     * to the channel sums of the current block row right after it has written
+     * them. The remaining texels are added when the line is finished, because
+     * the HBLANK area and the last cycle are modified after colorization.
+     * Lines that haven't been colorized, e.g., reused lines, are added as a
+     * whole. All rows that have not been computed this way are computed when
+     * the frame is complete.
+     */
+    isize scale;
+    Buffer <u32> reduced;
+    bool reducedRow[VPIXELS / 2];
+
+    // Channel sums of the block row in progress (red and blue, green and alpha)
+    Buffer <u32> sumRB;
+    Buffer <u32> sumGA;
+
+    // The block row the sums belong to and the number of rows added so far
+    isize sumBlock;
+    isize sumRows;
+
+    // Indicates if the visible area of a row has been added by the colorizer
+    bool accumulated[VPIXELS];
+
+    // Texels added by the colorizer
+    static constexpr Pixel visibleStart = 4 * HBLANK_CNT;
+    static constexpr Pixel visibleEnd = 4 * HPOS_MAX;
+
+    /* Viewport-cropped copy of the pixel buffer. If viewport cropping is
+     * enabled, the PixelEngine copies the area covered by the display window
+     * into this buffer when the frame is complete. The area starts at texel
+     * (cropX, cropY) of the pixel buffer. The buffer is organized in rows of
+     * cropWidth texels. It contains cropHeight rows. Both values are 0 if the
+     * frame has not been cropped.
+     */
+    isize cropX;
+    isize cropY;
+    isize cropWidth;
+    isize cropHeight;
+    Buffer <Texel> cropped;
+
     FrameBuffer();
 
+    // Checks whether a row has changed
+    bool isDirty(isize row) const { return dirty[row >> 5] & (1 << (row & 31)); }
+
+    // Marks all rows as changed
+    void markAllDirty();
+
+    // Fills the compact representation of the pixel buffer
+    void convert(TextureFormat format);
+
+    // Fills the reduced-resolution copy of the pixel buffer
+    void reduce(OutputResolution resolution);
+
+    // Adds a freshly colorized section of a row to the reduced-resolution copy
+    void accumulate(OutputResolution resolution, isize row, Pixel from, Pixel to);
+
+    // Adds a finished row to the reduced-resolution copy
+    void reduce(OutputResolution resolution, isize row);
+
+    // Discards all computed and partially computed reduced rows
+    void discardReducedRows();
+
+    // Fills the viewport-cropped copy of the pixel buffer
+    void crop(isize x1, isize y1, isize x2, isize y2);
+
+private:
+
+    void convertRGB565(isize row);
+    void convertRGBA4444(isize row);
+    void convertIndexed(isize row);
+    isize convertIndexed(const u32 *src, u8 *dst, u32 *palette);
+    template <isize s> void reduce(isize row);
+    template <isize s> void accumulate(isize row, Pixel from, Pixel to);
+    template <isize s> void finish(isize row);
+    void setScale(isize s);
+
+public:
+
     // Initializes (a portion of) the frame buffer with a checkerboard pattern
     void clear();
     void clear(isize row);
@@ -10,9 +10,11 @@
 #include "config.h"
 #include "PixelEngine.h"
 #include "Amiga.h"
+#include "Checksum.h"
 #include "Colors.h"
 #include "Denise.h"
 #include "DmaDebugger.h"
+#include "SIMDUtils.h"
 
 #include <fstream>
 
@@ -27,11 +29,16 @@ PixelEngine::PixelEngine(Amiga& ref) : SubComponent(ref)
     }
 }
 
+PixelEngine::~PixelEngine()
+{
+    stopWorker();
+}
+
 void
 PixelEngine::clearAll()
 {
-    emuTexture[0].clear();
-    emuTexture[1].clear();
+    finishColorizing();
+    for (auto &texture : emuTexture) texture.clear();
 }
 
 void
@@ -49,6 +56,18 @@ PixelEngine::_dump(Category category, std::ostream& os) const
         os << dec(config.contrast) << std::endl;
         os << tab("Saturation");
         os << dec(config.saturation) << std::endl;
+        os << tab("Texture format");
+        os << TextureFormatEnum::key(config.format) << std::endl;
+        os << tab("Output resolution");
+        os << OutputResolutionEnum::key(config.resolution) << std::endl;
+        os << tab("Viewport cropping");
+        os << bol(config.cropping) << std::endl;
+        os << tab("Pipelining");
+        os << bol(config.pipelining) << std::endl;
+        os << tab("Warp frame skip");
+        os << dec(config.warpFrameSkip) << std::endl;
+        os << tab("Dirty row tracking");
+        os << bol(config.dirtyTracking) << std::endl;
     }
 }
 
@@ -69,23 +88,36 @@ PixelEngine::_initialize()
 void
 PixelEngine::_reset(bool hard)
 {
+    finishColorizing();
+
     RESET_SNAPSHOT_ITEMS(hard)
     
     if (hard) {
         
-        emuTexture[0].nr = 0;
-        emuTexture[0].lof = emuTexture[0].prevlof = true;
-        emuTexture[1].nr = 0;
-        emuTexture[1].lof = emuTexture[1].prevlof = true;
+        for (auto &texture : emuTexture) {
+
+            texture.nr = 0;
+            texture.lof = texture.prevlof = true;
+        }
     }
 
-    activeBuffer = 0;
+    workingBuffer = 0;
+    latestBuffer = 1;
+    previousBuffer = 1;
+    stableBuffer = 2;
+    skipping = false;
+    warpFrames = 0;
+    rowHashNr[0] = rowHashNr[1] = -1;
+    for (auto &texture : emuTexture) texture.discardReducedRows();
     updateRGBA();
 }
 
 isize
 PixelEngine::didLoadFromBuffer(const u8 *buffer)
 {
+    finishColorizing();
+    rowHashNr[0] = rowHashNr[1] = -1;
+    for (auto &texture : emuTexture) texture.discardReducedRows();
     updateRGBA();
     return 0;
 }
@@ -107,7 +139,13 @@ PixelEngine::resetConfig()
         OPT_PALETTE,
         OPT_BRIGHTNESS,
         OPT_CONTRAST,
-        OPT_SATURATION
+        OPT_SATURATION,
+        OPT_TEXTURE_FORMAT,
+        OPT_OUTPUT_RESOLUTION,
+        OPT_VIEWPORT_CROPPING,
+        OPT_PIPELINING,
+        OPT_WARP_FRAME_SKIP,
+        OPT_DIRTY_TRACKING
     };
 
     for (auto &option : options) {
@@ -120,10 +158,16 @@ PixelEngine::getConfigItem(Option option) const
 {
     switch (option) {
             
-        case OPT_PALETTE:     return config.palette;
-        case OPT_BRIGHTNESS:  return config.brightness;
-        case OPT_CONTRAST:    return config.contrast;
-        case OPT_SATURATION:  return config.saturation;
+        case OPT_PALETTE:           return config.palette;
+        case OPT_BRIGHTNESS:        return config.brightness;
+        case OPT_CONTRAST:          return config.contrast;
+        case OPT_SATURATION:        return config.saturation;
+        case OPT_TEXTURE_FORMAT:    return config.format;
+        case OPT_OUTPUT_RESOLUTION: return config.resolution;
+        case OPT_VIEWPORT_CROPPING: return config.cropping;
+        case OPT_PIPELINING:        return config.pipelining;
+        case OPT_WARP_FRAME_SKIP:   return config.warpFrameSkip;
+        case OPT_DIRTY_TRACKING:    return config.dirtyTracking;
 
         default:
             fatalError;
@@ -132,6 +176,28 @@ PixelEngine::getConfigItem(Option option) const
 
 void
 PixelEngine::setConfigItem(Option option, i64 value)
+{
+    /* The colorizer thread reads the color tables and writes into the frame
+     * buffers. Hence, while the thread is running (or about to be started or
+     * stopped), the emulator thread is suspended and all queued lines are
+     * finished before the configuration changes. Because the emulator thread
+     * is suspended, the queue still has a single producer.
+     */
+    if (worker.joinable() || option == OPT_PIPELINING) {
+
+        SUSPENDED
+
+        finishColorizing();
+        _setConfigItem(option, value);
+
+    } else {
+
+        _setConfigItem(option, value);
+    }
+}
+
+void
+PixelEngine::_setConfigItem(Option option, i64 value)
 {
     switch (option) {
             
@@ -175,6 +241,49 @@ PixelEngine::setConfigItem(Option option, i64 value)
             updateRGBA();
             return;
 
+        case OPT_TEXTURE_FORMAT:
+
+            if (!TextureFormatEnum::isValid(value)) {
+                throw VAError(ERROR_OPT_INVARG, TextureFormatEnum::keyList());
+            }
+
+            config.format = (TextureFormat)value;
+            return;
+
+        case OPT_OUTPUT_RESOLUTION:
+
+            if (!OutputResolutionEnum::isValid(value)) {
+                throw VAError(ERROR_OPT_INVARG, OutputResolutionEnum::keyList());
+            }
+
+            config.resolution = (OutputResolution)value;
+            return;
+
+        case OPT_VIEWPORT_CROPPING:
+
+            config.cropping = (bool)value;
+            return;
+
+        case OPT_PIPELINING:
+
+            config.pipelining = (bool)value;
+            config.pipelining ? startWorker() : stopWorker();
+            return;
+
+        case OPT_WARP_FRAME_SKIP:
+
+            if (value < 1 || value > 50) {
+                throw VAError(ERROR_OPT_INVARG, "1...50");
+            }
+
+            config.warpFrameSkip = (isize)value;
+            return;
+
+        case OPT_DIRTY_TRACKING:
+
+            config.dirtyTracking = (bool)value;
+            return;
+
         default:
             fatalError;
     }
@@ -194,6 +303,9 @@ PixelEngine::setColor(isize reg, u16 value)
 
     // Update halfbright palette entry
     palette[reg + 32] = colorSpace[newColor.ehb().rawValue()];
+
+    // Invalidate the palette checksum
+    paletteHash = 0;
 }
 
 void
@@ -297,13 +409,26 @@ PixelEngine::adjustRGB(u8 &r, u8 &g, u8 &b)
 const FrameBuffer &
 PixelEngine::getStableBuffer()
 {
-    return emuTexture[!activeBuffer];
+    return emuTexture[previousBuffer];
+}
+
+const FrameBuffer &
+PixelEngine::acquireFrame()
+{
+    // Pick up the latest completed frame if it hasn't been consumed yet
+    if (latestBuffer.load(std::memory_order_relaxed) & 4) {
+
+        auto latest = latestBuffer.exchange(u8(stableBuffer), std::memory_order_acquire);
+        stableBuffer = latest & 3;
+    }
+
+    return emuTexture[stableBuffer];
 }
 
 FrameBuffer &
 PixelEngine::getWorkingBuffer()
 {
-    return emuTexture[activeBuffer];
+    return emuTexture[workingBuffer];
 }
 
 Texel *
@@ -327,14 +452,105 @@ PixelEngine::stablePtr(isize row, isize col)
 void
 PixelEngine::swapBuffers()
 {
-    isize oldActiveBuffer = activeBuffer;
-    isize newActiveBuffer = !oldActiveBuffer;
+    auto &completed = emuTexture[workingBuffer];
+    completed.seq = ++frameSeq;
+
+    // Publish the completed frame and continue with the previous one
+    auto latest = latestBuffer.exchange(u8(workingBuffer | 4), std::memory_order_acq_rel);
+    previousBuffer = workingBuffer;
+    workingBuffer = latest & 3;
+
+    emuTexture[workingBuffer].nr = agnus.pos.frame;
+    emuTexture[workingBuffer].lof = agnus.pos.lof;
+    emuTexture[workingBuffer].prevlof = completed.lof;
+    emuTexture[workingBuffer].repeated = true;
+}
+
+void
+PixelEngine::computeDirtyRows()
+{
+    auto &buffer = getWorkingBuffer();
+
+    // The row checksums are only needed for dirty row tracking and conversion
+    if (!config.dirtyTracking && config.format == TEXFMT_RGBA8888) {
 
-    emuTexture[newActiveBuffer].nr = agnus.pos.frame;
-    emuTexture[newActiveBuffer].lof = agnus.pos.lof;
-    emuTexture[newActiveBuffer].prevlof = emuTexture[oldActiveBuffer].lof;
+        buffer.markAllDirty();
+        rowHashNr[0] = rowHashNr[1] = -1;
+        return;
+    }
+    auto &previous = emuTexture[previousBuffer];
+    auto *hash = rowHash[buffer.lof];
+    bool valid = rowHashNr[buffer.lof] >= 0;
 
-    activeBuffer = newActiveBuffer;
+    // Reused rows equal the rows of the previous frame if it has been hashed
+    bool reused = valid && rowHashNr[buffer.lof] == previous.nr;
+
+    std::memset(buffer.dirty, 0, sizeof(buffer.dirty));
+    buffer.dirtyBase = rowHashNr[buffer.lof];
+    buffer.firstDirty = VPIXELS;
+    buffer.lastDirty = -1;
+
+    for (isize row = 0; row < VPIXELS; row++) {
+
+        // Skip rows that have been reused from the previous frame
+        auto fp = buffer.fingerprint[row];
+        if (reused && fp && fp == previous.fingerprint[row]) continue;
+
+        auto *ptr = (u64 *)(buffer.pixels.ptr + row * HPIXELS);
+        auto checksum = util::fnv64(ptr, HPIXELS * isizeof(Texel) / 8);
+
+        if (!valid || checksum != hash[row]) {
+
+            buffer.dirty[row >> 5] |= 1 << (row & 31);
+            buffer.firstDirty = std::min(buffer.firstDirty, row);
+            buffer.lastDirty = row;
+        }
+        hash[row] = checksum;
+    }
+
+    // Reused rows have kept the checksum of the row they have been copied from
+    std::memcpy(buffer.checksum, hash, sizeof(buffer.checksum));
+    rowHashNr[buffer.lof] = buffer.nr;
+}
+
+bool
+PixelEngine::assignFingerprint(isize row, u64 fingerprint)
+{
+    auto &buffer = getWorkingBuffer();
+    auto &previous = emuTexture[previousBuffer];
+
+    // Overlays of the DMA debugger are not covered by the fingerprint
+    if (NO_LINE_REUSE || dmaDebugger.getConfig().enabled) fingerprint = 0;
+
+    buffer.fingerprint[row] = fingerprint;
+
+    if (fingerprint && fingerprint == previous.fingerprint[row]) return true;
+
+    buffer.repeated = false;
+    return false;
+}
+
+bool
+PixelEngine::reuseRow(isize row, u64 fingerprint)
+{
+    if (!assignFingerprint(row, fingerprint)) return false;
+
+    std::memcpy(workingPtr(row), emuTexture[previousBuffer].pixels.ptr + row * HPIXELS,
+                HPIXELS * sizeof(Texel));
+    return true;
+}
+
+u64
+PixelEngine::getPaletteHash()
+{
+    if (!paletteHash) {
+
+        // HAM mode utilizes the color registers directly
+        auto hash1 = util::fnv64((u64 *)palette, isizeof(palette) / 8);
+        auto hash2 = util::fnv64((u8 *)color, isizeof(color));
+        paletteHash = (hash1 ^ hash2 << 1) | 1;
+    }
+    return paletteHash;
 }
 
 Texel *
@@ -353,12 +569,61 @@ PixelEngine::vsyncHandler()
 void
 PixelEngine::eofHandler()
 {
-    swapBuffers();
+    auto &buffer = getWorkingBuffer();
+
+    // Wait until all lines of this frame have been colorized
+    finishColorizing();
+
+    if (skipping) {
+
+        // Keep the working buffer and draw the next frame into it
+        buffer.prevlof = buffer.lof;
+        buffer.nr = agnus.pos.frame;
+        buffer.lof = agnus.pos.lof;
+        buffer.repeated = true;
+
+    } else {
+
+        computeDirtyRows();
+        buffer.reduce(config.resolution);
+
+        // Crop the frame to the viewport if requested
+        if (config.cropping && denise.getConfig().viewportTracking) {
+
+            // Number of border pixels to keep around the display window
+            constexpr isize margin = 8;
+
+            auto vp = denise.debugger.getMaxViewPort();
+            auto hblank = 4 * HBLANK_MIN;
+
+            buffer.crop(2 * vp.hstrt - hblank - margin, vp.vstrt - margin,
+                        2 * vp.hstop - hblank + margin, vp.vstop + margin);
+
+        } else {
+
+            buffer.crop(0, 0, 0, 0);
+        }
+
+        buffer.convert(config.format);
+        swapBuffers();
+    }
+
+    // In warp mode, only draw every n-th frame if requested
+    if (amiga.isWarping() && config.warpFrameSkip > 1) {
+
+        skipping = ++warpFrames % config.warpFrameSkip != 0;
+
+    } else {
+
+        skipping = false;
+        warpFrames = 0;
+    }
+
     dmaDebugger.eofHandler();
 }
 
 void
-PixelEngine::endOfVBlankLine()
+PixelEngine::applyRegisterChanges()
 {
     // Apply all color register changes that happened in this line
     for (isize i = 0, end = colChanges.end(); i < end; i++) {
@@ -394,11 +659,62 @@ PixelEngine::applyRegisterChange(const RegChange &change)
     }
 }
 
+void
+PixelEngine::applyRegisterChange(const RegChange &change, LineJob &job) const
+{
+    switch (change.addr) {
+
+        case 0:
+
+            break;
+
+        case 0x100: // BPLCON0
+
+            job.hamMode = Denise::ham(change.value);
+            job.shresMode = Denise::shres(change.value);
+            break;
+
+        default: // It must be a color register then
+
+            auto nr = (change.addr - 0x180) >> 1;
+            assert(nr < 32);
+
+            job.color[nr] = AmigaColor(change.value & 0xFFF);
+            job.palette[nr] = colorSpace[change.value & 0xFFF];
+            job.palette[nr + 32] = colorSpace[job.color[nr].ehb().rawValue()];
+            break;
+    }
+}
+
+PixelEngine::ColorizerInput
+PixelEngine::getColorizerInput() const
+{
+    return ColorizerInput {
+
+        denise.bBuffer, denise.iBuffer, denise.mBuffer, denise.zBuffer, color, palette
+    };
+}
+
+OutputResolution
+PixelEngine::reduction() const
+{
+    // Overlays are drawn after the line has been colorized
+    if (denise.hasOverlays()) return OUTRES_FULL;
+
+    // The colorizer thread may still be working on the current block
+    if (queuedRow >= 0) return OUTRES_FULL;
+
+    return config.resolution;
+}
+
 void
 PixelEngine::colorize(isize line)
 {
     // Jump to the first pixel in the specified line in the active frame buffer
+    auto &buffer = getWorkingBuffer();
     auto *dst = workingPtr(line);
+    auto in = getColorizerInput();
+    auto resolution = reduction();
     Pixel pixel = 0;
 
     // Initialize the HAM mode hold register with the current background color
@@ -415,12 +731,13 @@ PixelEngine::colorize(isize line)
 
         // Colorize a chunk of pixels
         if (shresMode) {
-            colorizeSHRES(dst, pixel, trigger);
+            colorizeSHRES(dst, in, pixel, trigger);
         } else if (hamMode) {
-            colorizeHAM(dst, pixel, trigger, hold);
+            colorizeHAM(dst, in, pixel, trigger, hold);
         } else {
-            colorize(dst, pixel, trigger);
+            colorize(dst, in, pixel, trigger);
         }
+        buffer.accumulate(resolution, line, pixel, trigger);
         pixel = trigger;
 
         // Perform the register change
@@ -431,38 +748,238 @@ PixelEngine::colorize(isize line)
     colChanges.clear();
 
     // Wipe out the HBLANK area
+    wipeHBlank(dst);
+}
+
+void
+PixelEngine::colorizeAsync(isize line)
+{
+    auto &job = jobs.back();
+
+    job.buffer = &getWorkingBuffer();
+    job.row = line;
+    job.hires = agnus.res != LORES;
+    job.shortLine = agnus.pos.hLatched == HPOS_CNT_PAL;
+    job.draw = true;
+    job.resolution = denise.hasOverlays() ? OUTRES_FULL : config.resolution;
+
+    // Record the color state at the beginning of the line
+    std::memcpy(job.color, color, sizeof(color));
+    std::memcpy(job.palette, palette, sizeof(palette));
+    job.hamMode = hamMode;
+    job.shresMode = shresMode;
+    job.colChanges.clear();
+    for (isize i = 0, end = colChanges.end(); i < end; i++) {
+        job.colChanges.insert(colChanges.keys[i], colChanges.elements[i]);
+    }
+
+    // Record the output of the previous pipeline stages
+    std::memcpy(job.mBuffer, denise.mBuffer, sizeof(job.mBuffer));
+    if (hamMode || shresMode || !colChanges.isEmpty()) {
+
+        std::memcpy(job.bBuffer, denise.bBuffer, sizeof(job.bBuffer));
+        std::memcpy(job.iBuffer, denise.iBuffer, sizeof(job.iBuffer));
+        std::memcpy(job.zBuffer, denise.zBuffer, sizeof(job.zBuffer));
+    }
+
+    jobs.push();
+    queuedRow = line;
+
+    // Bring the color state up to date
+    applyRegisterChanges();
+}
+
+void
+PixelEngine::colorize(LineJob &job)
+{
+    ColorizerInput in = {
+
+        job.bBuffer, job.iBuffer, job.mBuffer, job.zBuffer, job.color, job.palette
+    };
+
+    auto *dst = job.buffer->pixels.ptr + job.row * HPIXELS;
+    auto &changes = job.colChanges;
+    Pixel pixel = 0;
+
+    // Initialize the HAM mode hold register with the current background color
+    AmigaColor hold = job.color[0];
+
+    // Add a dummy register change to ensure we draw until the line end
+    changes.insert(HPIXELS, RegChange { SET_NONE, 0 } );
+
+    for (isize i = 0, end = changes.end(); i < end; i++) {
+
+        Pixel trigger = (Pixel)changes.keys[i];
+
+        if (job.shresMode) {
+            colorizeSHRES(dst, in, pixel, trigger);
+        } else if (job.hamMode) {
+            colorizeHAM(dst, in, pixel, trigger, hold);
+        } else {
+            colorize(dst, in, pixel, trigger);
+        }
+        job.buffer->accumulate(job.resolution, job.row, pixel, trigger);
+        pixel = trigger;
+
+        applyRegisterChange(changes.elements[i], job);
+    }
+
+    wipeHBlank(dst);
+
+    // Perform the remaining steps of Denise::hsyncHandler() and Agnus::hsyncHandler()
+    if (job.shortLine) job.buffer->clear(job.row, HPOS_MAX);
+    REPLACE_BIT(dst[0], 28, job.hires);
+}
+
+void
+PixelEngine::finishColorizing()
+{
+    if (worker.joinable()) jobs.drain();
+    queuedRow = -1;
+}
+
+void
+PixelEngine::reduceLine(isize line)
+{
+    if (config.resolution == OUTRES_FULL || skipping) return;
+
+    // Frames with overlays are reduced at the end of the frame
+    if (denise.hasOverlays()) return;
+
+    // Lines handed over to the colorizer thread are reduced there
+    if (isQueued(line)) return;
+
+    if (queuedRow >= 0) {
+
+        // Let the colorizer thread reduce the line after the queued lines
+        auto &job = jobs.back();
+
+        job.buffer = &getWorkingBuffer();
+        job.row = line;
+        job.draw = false;
+        job.resolution = config.resolution;
+        jobs.push();
+
+    } else {
+
+        getWorkingBuffer().reduce(config.resolution, line);
+    }
+}
+
+void
+PixelEngine::startWorker()
+{
+    if (worker.joinable()) return;
+
+    worker = std::thread([this]() {
+
+        while (true) {
+
+            auto &job = jobs.front();
+            if (!job.buffer) break;
+
+            if (job.draw) colorize(job);
+            job.buffer->reduce(job.resolution, job.row);
+            jobs.pop();
+        }
+        jobs.pop();
+    });
+}
+
+void
+PixelEngine::stopWorker()
+{
+    if (!worker.joinable()) return;
+
+    // Let the thread finish all queued lines and pop the sentinel
+    jobs.back().buffer = nullptr;
+    jobs.push();
+    jobs.drain();
+    worker.join();
+    queuedRow = -1;
+}
+
+void
+PixelEngine::wipeHBlank(Texel *dst)
+{
     auto start = agnus.pos.pixel(HBLANK_MIN);
     auto stop  = agnus.pos.pixel(HBLANK_MAX);
-    for (pixel = start; pixel <= stop; pixel++) dst[pixel] = FrameBuffer::hblank;
+    for (Pixel pixel = start; pixel <= stop; pixel++) dst[pixel] = FrameBuffer::hblank;
 }
 
 void
-PixelEngine::colorize(Texel *dst, Pixel from, Pixel to)
+PixelEngine::colorize(isize line, Pixel from, Pixel to)
 {
-    u8 *mbuf = denise.mBuffer;
+    colorize(workingPtr(line), getColorizerInput(), from, to);
+    getWorkingBuffer().accumulate(reduction(), line, from, to);
+}
 
-    for (Pixel i = from; i < to; i++) {
+void
+PixelEngine::colorize(Texel *dst, const ColorizerInput &in, Pixel from, Pixel to)
+{
+    auto *mbuf = in.mBuffer;
+    auto *palette = in.palette;
+    Pixel i = from;
+
+    if constexpr (!NO_VEC_COLORIZE && sizeof(Texel) == 4) {
+
+        /* WebAssembly offers no gather instruction. Hence, the palette lookups
+         * are still carried out one by one, but four texels are collected in a
+         * SIMD register and written with a single store.
+         */
+        for (; i + 4 <= to; i += 4) {
+
+            util::u32x4 texels = {
+                u32(palette[mbuf[i]]), u32(palette[mbuf[i + 1]]),
+                u32(palette[mbuf[i + 2]]), u32(palette[mbuf[i + 3]])
+            };
+            util::store(dst + i, texels);
+        }
+    }
+
+    // Colorize the remaining pixels
+    for (; i < to; i++) {
         dst[i] = palette[mbuf[i]];
     }
 }
 
 void
-PixelEngine::colorizeSHRES(Texel *dst, Pixel from, Pixel to)
+PixelEngine::colorizeSHRES(Texel *dst, const ColorizerInput &in, Pixel from, Pixel to)
 {
-    auto *mbuf = denise.mBuffer;
-    auto *zbuf = denise.zBuffer;
+    auto *mbuf = in.mBuffer;
+    auto *zbuf = in.zBuffer;
+    auto *palette = in.palette;
 
     if constexpr (sizeof(Texel) == 4) {
 
         // Output two super-hires pixels as a single texel
-        for (Pixel i = from; i < to; i++) {
-            dst[i] = palette[mbuf[i]];
-        }
+        colorize(dst, in, from, to);
 
     } else {
 
-        // Output each super-hires pixel as a seperate texel
-        for (Pixel i = from; i < to; i++) {
+        /* Output each super-hires pixel as a seperate texel. Sprite pixels
+         * occupy both halves of a texel. All other pixels encode the color
+         * indices of both super-hires pixels in the upper and lower bits.
+         */
+        Pixel i = from;
+
+        if constexpr (!NO_VEC_COLORIZE) {
+
+            for (; i + 2 <= to; i += 2) {
+
+                bool s0 = Denise::isSpritePixel(zbuf[i]);
+                bool s1 = Denise::isSpritePixel(zbuf[i + 1]);
+                u8 m0 = mbuf[i], m1 = mbuf[i + 1];
+
+                util::u32x4 texels = {
+                    u32(palette[s0 ? m0 : m0 >> 2]), u32(palette[s0 ? m0 : m0 & 3]),
+                    u32(palette[s1 ? m1 : m1 >> 2]), u32(palette[s1 ? m1 : m1 & 3])
+                };
+                util::store(dst + i, texels);
+            }
+        }
+
+        for (; i < to; i++) {
 
             u32 *p = (u32 *)(dst + i);
 
@@ -481,11 +998,14 @@ PixelEngine::colorizeSHRES(Texel *dst, Pixel from, Pixel to)
 }
 
 void
-PixelEngine::colorizeHAM(Texel *dst, Pixel from, Pixel to, AmigaColor& ham)
+PixelEngine::colorizeHAM(Texel *dst, const ColorizerInput &in, Pixel from, Pixel to, AmigaColor& ham)
 {
-    u8 *bbuf = denise.bBuffer;
-    u8 *ibuf = denise.iBuffer;
-    u8 *mbuf = denise.mBuffer;
+    auto *bbuf = in.bBuffer;
+    auto *ibuf = in.iBuffer;
+    auto *mbuf = in.mBuffer;
+    auto *zbuf = in.zBuffer;
+    auto *color = in.color;
+    auto *palette = in.palette;
 
     for (Pixel i = from; i < to; i++) {
 
@@ -519,7 +1039,7 @@ PixelEngine::colorizeHAM(Texel *dst, Pixel from, Pixel to, AmigaColor& ham)
         }
 
         // Synthesize pixel
-        if (denise.spritePixelIsVisible(i)) {
+        if ((zbuf[i] & Denise::Z_SP01234567) > (zbuf[i] & ~Denise::Z_SP01234567)) {
             dst[i] = palette[mbuf[i]];
         } else {
             dst[i] = colorSpace[ham.rawValue()];
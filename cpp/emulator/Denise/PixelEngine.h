@@ -14,6 +14,8 @@
 #include "ChangeRecorder.h"
 #include "Constants.h"
 #include "FrameBuffer.h"
+#include "Concurrency.h"
+#include <atomic>
 
 namespace vamiga {
 
@@ -32,23 +34,49 @@ public:
 
 private:
 
-    /* The emulator utilizes double-buffering for the computed textures.
-     * At any time, one of the two buffers is the "working buffer". The other
+    /* The emulator utilizes triple-buffering for the computed textures. At
+     * any time, one of the three buffers is the "working buffer" and another
      * one is the "stable buffer". All drawing functions write to the working
-     * buffer and the GPU reads from the stable buffer. Once a frame has
-     * been completed, the working buffer and the stable buffer are swapped.
+     * buffer and the GPU reads from the stable buffer. The third buffer holds
+     * the latest completed frame. Once a frame has been completed, it is
+     * exchanged with the working buffer. When the consumer acquires a frame,
+     * the stable buffer is exchanged with the third buffer if the latter holds
+     * a newer frame. Both exchanges are atomic. Hence, the emulator never waits
+     * for the consumer and the consumer always gets the latest completed frame.
+     * There must be a single consumer only. Components running inside the
+     * emulator thread read the latest completed frame via getStableBuffer(),
+     * which doesn't consume anything.
      */
-    FrameBuffer emuTexture[2];
+    FrameBuffer emuTexture[3];
 
-    // The currently active buffer
-    isize activeBuffer = 0;
+    // Indices of the working buffer and the stable buffer
+    isize workingBuffer = 0;
+    isize stableBuffer = 2;
 
-    // Mutex for synchronizing access to the stable buffer
-    util::Mutex bufferMutex;
+    // Index of the latest completed frame (bit 2 is set if not yet consumed)
+    std::atomic<u8> latestBuffer = 1;
+
+    // Index of the frame that has been completed before the working buffer
+    isize previousBuffer = 1;
+
+    // Number of completed frames
+    i64 frameSeq = 0;
+
+    // Indicates if the current frame is not drawn (warp mode frame skipping)
+    bool skipping = false;
+
+    // Number of frames that have been emulated in warp mode
+    i64 warpFrames = 0;
 
     // Buffer with background noise (random black and white pixels)
     Buffer <Texel> noise;
 
+    // Row checksums of the latest long frame and the latest short frame
+    u64 rowHash[2][VPIXELS];
+
+    // Frame numbers the row checksums belong to (-1 = no checksums)
+    i64 rowHashNr[2] = { -1, -1 };
+
     
     //
     // Color management
@@ -69,6 +97,9 @@ private:
      */
     static const int paletteCnt = 32 + 32 + 1 + 3;
     Texel palette[paletteCnt];
+
+    // Checksum of the active color palette (0 = needs to be recomputed)
+    u64 paletteHash = 0;
     
     // Indicates whether HAM mode or SHRES mode is enabled
     bool hamMode;
@@ -85,6 +116,71 @@ public:
     RegChangeRecorder<128> colChanges;
 
 
+    //
+    // Pipelining
+    //
+
+private:
+
+    // Pointers to the data read by the colorizer
+    struct ColorizerInput {
+
+        const u8 *bBuffer;
+        const u8 *iBuffer;
+        const u8 *mBuffer;
+        const u16 *zBuffer;
+        const AmigaColor *color;
+        const Texel *palette;
+    };
+
+    /* In pipelined mode, rasterlines are colorized by a separate thread. For
+     * each line, the emulator thread records everything the colorizer depends
+     * on and hands the record over via a single-producer single-consumer queue.
+     */
+    struct LineJob {
+
+        // Destination of the colorized pixels (nullptr stops the worker)
+        FrameBuffer *buffer;
+        isize row;
+
+        // Indicates if the HIRES marker is set in the first pixel
+        bool hires;
+
+        // Indicates if the last pixels of a short line need to be cleared
+        bool shortLine;
+
+        // Indicates if the row is colorized (false: the row is only reduced)
+        bool draw;
+
+        // Output resolution the row is reduced to
+        OutputResolution resolution;
+
+        // Color state at the beginning of the line
+        AmigaColor color[32];
+        Texel palette[paletteCnt];
+        bool hamMode;
+        bool shresMode;
+
+        // Color register changes of this line
+        RegChangeRecorder<128> colChanges;
+
+        // Output of the previous pipeline stages (mBuffer only for plain lines)
+        u8 bBuffer[HPIXELS];
+        u8 iBuffer[HPIXELS];
+        u8 mBuffer[HPIXELS];
+        u16 zBuffer[HPIXELS];
+    };
+
+    // Line records waiting to be colorized
+    util::SPSCQueue<LineJob, 16> jobs;
+
+    // The colorizer thread
+    std::thread worker;
+
+    // The last row that has been handed over to the colorizer thread
+    isize queuedRow = -1;
+
+
     //
     // Initializing
     //
@@ -92,8 +188,9 @@ public:
 public:
     
     PixelEngine(Amiga& ref);
+    ~PixelEngine();
 
-    // Initializes both frame buffers with a checkerboard pattern
+    // Initializes all frame buffers with a checkerboard pattern
     void clearAll();
 
 
@@ -129,6 +226,10 @@ public:
     i64 getConfigItem(Option option) const;
     void setConfigItem(Option option, i64 value);
 
+private:
+
+    void _setConfigItem(Option option, i64 value);
+
     
     //
     // Serializing
@@ -208,22 +309,56 @@ private:
 
 public:
 
-    // Returns the working buffer or the stable buffer
+    // Returns the working buffer or the latest completed frame
     FrameBuffer &getWorkingBuffer();
     const FrameBuffer &getStableBuffer();
 
     // Return a pointer into the pixel storage
     Texel *workingPtr(isize row = 0, isize col = 0);
     Texel *stablePtr(isize row = 0, isize col = 0);
-    
-    // Swaps the working buffer and the stable buffer
+
+    // Hands the latest completed frame over to the consumer (GPU)
+    const FrameBuffer &acquireFrame();
+
+    // Publishes the working buffer
     void swapBuffers();
+
+    // Indicates if the current frame is emulated without being drawn
+    bool isSkipping() const { return skipping; }
+
+private:
+
+    /* Compares the working buffer with the previous frame of the same type.
+     * Rows reused from the previous frame are not hashed again. If neither
+     * dirty row tracking nor texture conversion needs the row checksums,
+     * nothing is hashed and all rows are marked as dirty.
+     */
+    void computeDirtyRows();
+
+public:
+
+    /* Assigns a fingerprint to a row of the working buffer. The function
+     * returns true if the row of the previous frame has the same fingerprint.
+     * Rows with fingerprint 0 never match.
+     */
+    bool assignFingerprint(isize row, u64 fingerprint);
+
+    /* Assigns a fingerprint to a row of the working buffer. If the row of the
+     * previous frame has the same fingerprint, its contents are copied over
+     * and true is returned.
+     */
+    bool reuseRow(isize row, u64 fingerprint);
+
+    // Returns the checksum of the active color palette
+    u64 getPaletteHash();
+
+public:
     
     // Returns a pointer to randon noise
     Texel *getNoise() const;
 
-    // Called after each line in the VBLANK area
-    void endOfVBlankLine();
+    // Applies all color register changes of a line that isn't drawn
+    void applyRegisterChanges();
 
     // Called after each frame to switch the frame buffers
     void vsyncHandler();
@@ -240,6 +375,11 @@ public:
     // Applies a register change
     void applyRegisterChange(const RegChange &change);
 
+private:
+
+    // Applies a register change to the color state of a line record
+    void applyRegisterChange(const RegChange &change, LineJob &job) const;
+
 
     //
     // Synthesizing pixels
@@ -252,12 +392,49 @@ public:
      * line of RGBA values in GPU format.
      */
     void colorize(isize line);
-    
+
+    /* Hands a rasterline over to the colorizer thread. The last stage of the
+     * graphics pipeline is carried out asynchronously in this case.
+     */
+    void colorizeAsync(isize line);
+
+    /* Checks whether a row is the last row that has been handed over to the
+     * colorizer thread since the last synchronization. Rows handed over
+     * before this one are not tracked.
+     */
+    bool isQueued(isize line) const { return line == queuedRow; }
+
+    // Waits until the colorizer thread has processed all queued lines
+    void finishColorizing();
+
+    /* Reduces the resolution of a completed row. The colorizer has already
+     * added the visible area of the row to the reduced-resolution copy. The
+     * function adds the remaining texels and computes the block if the row
+     * completes it. Frames with overlays are reduced at the end of the frame.
+     */
+    void reduceLine(isize line);
+
 private:
-    
-    void colorize(Texel *dst, Pixel from, Pixel to);
-    void colorizeSHRES(Texel *dst, Pixel from, Pixel to);
-    void colorizeHAM(Texel *dst, Pixel from, Pixel to, AmigaColor& ham);
+
+    ColorizerInput getColorizerInput() const;
+
+    // Returns the resolution the colorizer reduces to on the emulator thread
+    OutputResolution reduction() const;
+
+    void colorize(isize line, Pixel from, Pixel to);
+    void colorize(Texel *dst, const ColorizerInput &in, Pixel from, Pixel to);
+    void colorizeSHRES(Texel *dst, const ColorizerInput &in, Pixel from, Pixel to);
+    void colorizeHAM(Texel *dst, const ColorizerInput &in, Pixel from, Pixel to, AmigaColor& ham);
+
+    // Colorizes a line record (executed by the colorizer thread)
+    void colorize(LineJob &job);
+
+    // Starts or stops the colorizer thread
+    void startWorker();
+    void stopWorker();
+
+    // Fills the HBLANK area of a rasterline
+    void wipeHBlank(Texel *dst);
     
     /* Hides some graphics layers. This function is an optional stage applied
      * after colorize(). It can be used to hide some layers for debugging.
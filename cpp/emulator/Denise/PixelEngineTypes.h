@@ -52,6 +52,66 @@ struct PaletteEnum : util::Reflection<PaletteEnum, Palette>
 };
 #endif
 
+enum_long(TEXFMT)
+{
+    TEXFMT_RGBA8888,
+    TEXFMT_RGB565,
+    TEXFMT_RGBA4444,
+    TEXFMT_INDEXED
+};
+typedef TEXFMT TextureFormat;
+
+#ifdef __cplusplus
+struct TextureFormatEnum : util::Reflection<TextureFormatEnum, TextureFormat>
+{
+    static constexpr long minVal = 0;
+    static constexpr long maxVal = TEXFMT_INDEXED;
+    static bool isValid(auto val) { return val >= minVal && val <= maxVal; }
+
+    static const char *prefix() { return "TEXFMT"; }
+    static const char *key(TextureFormat value)
+    {
+        switch (value) {
+
+            case TEXFMT_RGBA8888:      return "RGBA8888";
+            case TEXFMT_RGB565:        return "RGB565";
+            case TEXFMT_RGBA4444:      return "RGBA4444";
+            case TEXFMT_INDEXED:       return "INDEXED";
+        }
+        return "???";
+    }
+};
+#endif
+
+enum_long(OUTRES)
+{
+    OUTRES_FULL,
+    OUTRES_HALF,
+    OUTRES_QUARTER
+};
+typedef OUTRES OutputResolution;
+
+#ifdef __cplusplus
+struct OutputResolutionEnum : util::Reflection<OutputResolutionEnum, OutputResolution>
+{
+    static constexpr long minVal = 0;
+    static constexpr long maxVal = OUTRES_QUARTER;
+    static bool isValid(auto val) { return val >= minVal && val <= maxVal; }
+
+    static const char *prefix() { return "OUTRES"; }
+    static const char *key(OutputResolution value)
+    {
+        switch (value) {
+
+            case OUTRES_FULL:          return "FULL";
+            case OUTRES_HALF:          return "HALF";
+            case OUTRES_QUARTER:       return "QUARTER";
+        }
+        return "???";
+    }
+};
+#endif
+
 //
 // Structures
 //
@@ -62,5 +122,11 @@ typedef struct
     isize brightness;
     isize contrast;
     isize saturation;
+    TextureFormat format;
+    OutputResolution resolution;
+    bool cropping;
+    bool pipelining;
+    isize warpFrameSkip;
+    bool dirtyTracking;
 }
 PixelEngineConfig;
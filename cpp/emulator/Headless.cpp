@@ -11,6 +11,7 @@
 #include "Headless.h"
 #include "Script.h"
 #include "SelfTestScript.h"
+#include "SIMDUtils.h"
 #include <filesystem>
 #include <chrono>
 
@@ -70,6 +71,18 @@ Headless::main(int argc, char *argv[])
     // Parse all command line arguments
     parseArguments(argc, argv);
 
+    // Check the vectorized code paths against their scalar counterparts
+    if (keys.find("selftest") != keys.end()) {
+
+        std::cout << "Checking the planar to chunky conversion... ";
+        if (!util::checkTranspose(100000)) {
+
+            std::cout << "FAILED" << std::endl;
+            return 1;
+        }
+        std::cout << "OK" << std::endl;
+    }
+
     // Redirect shell output to the console in verbose mode
     if (keys.find("verbose") != keys.end()) amiga.retroShell.setStream(std::cout);
 
@@ -1056,6 +1056,7 @@ Memory::peek8 <ACCESSOR_CPU, MEM_CHIP> (u32 addr)
 {
     ASSERT_CHIP_ADDR(addr);
     agnus.executeUntilBusIsFree();
+    blitter.checkMemAccess(addr & chipMask);
     
     stats.chipReads.raw++;
     dataBus = READ_CHIP_8(addr);
@@ -1067,6 +1068,7 @@ Memory::peek16 <ACCESSOR_CPU, MEM_CHIP> (u32 addr)
 {
     ASSERT_CHIP_ADDR(addr);
     agnus.executeUntilBusIsFree();
+    blitter.checkMemAccess(addr & chipMask);
     
     stats.chipReads.raw++;
     dataBus = READ_CHIP_16(addr);
@@ -1580,6 +1582,8 @@ Memory::poke8 <ACCESSOR_CPU, MEM_CHIP> (u32 addr, u8 value)
     }
 
     agnus.executeUntilBusIsFree();
+    agnus.syncBplBatch();
+    blitter.checkMemAccess(addr & chipMask);
     
     stats.chipWrites.raw++;
     dataBus = value;
@@ -1598,6 +1602,8 @@ Memory::poke16 <ACCESSOR_CPU, MEM_CHIP> (u32 addr, u16 value)
     }
 
     agnus.executeUntilBusIsFree();
+    agnus.syncBplBatch();
+    blitter.checkMemAccess(addr & chipMask);
     
     stats.chipWrites.raw++;
     dataBus = value;
@@ -1610,6 +1616,7 @@ Memory::poke8 <ACCESSOR_CPU, MEM_SLOW> (u32 addr, u8 value)
     ASSERT_SLOW_ADDR(addr);
     
     agnus.executeUntilBusIsFree();
+    agnus.syncBplBatch();
     
     stats.slowWrites.raw++;
     dataBus = value;
@@ -1622,6 +1629,7 @@ Memory::poke16 <ACCESSOR_CPU, MEM_SLOW> (u32 addr, u16 value)
     ASSERT_SLOW_ADDR(addr);
     
     agnus.executeUntilBusIsFree();
+    agnus.syncBplBatch();
     
     stats.slowWrites.raw++;
     dataBus = value;
@@ -2198,6 +2206,9 @@ Memory::pokeCustom16(u32 addr, u16 value)
         trace(OCSREG_DEBUG, "pokeCustom16(%X [%s], %X)\n", addr, regName(addr), value);
     }
 
+    // Process all postponed bitplane events
+    agnus.syncBplBatch();
+
     dataBus = value;
 
     switch ((addr >> 1) & 0xFF) {
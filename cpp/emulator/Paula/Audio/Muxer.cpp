@@ -58,6 +58,8 @@ Muxer::_dump(Category category, std::ostream& os) const
         os << dec(config.volL) << std::endl;
         os << tab("Right master volume");
         os << dec(config.volR) << std::endl;
+        os << tab("Skip audio in warp mode");
+        os << bol(config.warpSkip) << std::endl;
     }
 
     if (category == Category::Inspection) {
@@ -84,6 +86,7 @@ Muxer::_reset(bool hard)
     RESET_SNAPSHOT_ITEMS(hard)
     
     stats = { };
+    skipped = false;
     
     for (isize i = 0; i < 4; i++) sampler[i].reset();
     clear();
@@ -115,7 +118,8 @@ Muxer::resetConfig()
         
         OPT_SAMPLING_METHOD,
         OPT_AUDVOLL,
-        OPT_AUDVOLR
+        OPT_AUDVOLR,
+        OPT_WARP_AUDIO_SKIP
     };
 
     for (auto &option : options) {
@@ -149,6 +153,9 @@ Muxer::getConfigItem(Option option) const
         case OPT_AUDVOLR:
             return config.volR;
 
+        case OPT_WARP_AUDIO_SKIP:
+            return config.warpSkip;
+
         default:
             fatalError;
     }
@@ -208,6 +215,11 @@ Muxer::setConfigItem(Option option, i64 value)
                 msgQueue.put(MSG_MUTE, isMuted());
             return;
 
+        case OPT_WARP_AUDIO_SKIP:
+
+            config.warpSkip = (bool)value;
+            return;
+
         case OPT_FILTER_TYPE:
         case OPT_FILTER_ACTIVATION:
 
@@ -313,6 +325,22 @@ Muxer::synthesize(Cycle clock, Cycle target)
 {
     assert(target > clock);
 
+    // Don't produce any samples in warp mode if requested
+    if (config.warpSkip && amiga.isWarping()) {
+
+        for (isize i = 0; i < 4; i++) sampler[i].trim(target);
+        fraction = 0.0;
+        skipped = true;
+        return;
+    }
+
+    // Fade in from silence if samples have been skipped
+    if (skipped) {
+
+        rampUpFromZero();
+        skipped = false;
+    }
+
     // Determine the number of elapsed cycles per audio sample
     double cps = double(amiga.masterClockFrequency()) / host.getSampleRate();
 
@@ -57,6 +57,9 @@ class Muxer : public SubComponent {
     // Fraction of a sample that hadn't been generated in synthesize
     double fraction = 0.0;
 
+    // Indicates if audio synthesis has been skipped in warp mode
+    bool skipped = false;
+
     // Time stamp of the last write pointer alignment
     util::Time lastAlignment;
 
@@ -212,7 +215,9 @@ public:
     // Entry point for the screen recorder
     void synthesize(Cycle clock, Cycle target, long count);
 
-    // Entry point for the core emulator
+    /* Entry point for the core emulator. If OPT_WARP_AUDIO_SKIP is set, no
+     * samples are produced in warp mode. Only the samplers are kept up to date.
+     */
     void synthesize(Cycle clock, Cycle target);
 
 private:
@@ -75,6 +75,15 @@ Sampler::interpolate(Cycle clock)
     }
 }
 
+void
+Sampler::trim(Cycle clock)
+{
+    assert(!isEmpty());
+
+    // Keep the sample that is valid at the specified cycle
+    for (isize r2 = next(r); r2 != w && keys[r2] <= clock; r2 = next(r)) skip();
+}
+
 template i16 Sampler::interpolate<SMP_NONE>(Cycle clock);
 template i16 Sampler::interpolate<SMP_NEAREST>(Cycle clock);
 template i16 Sampler::interpolate<SMP_LINEAR>(Cycle clock);
@@ -30,6 +30,9 @@ struct Sampler : util::SortedRingBuffer <i16, VPOS_CNT * HPOS_CNT_PAL> {
 
     // Interpolates a sound sample for the specified target cycle
     template <SamplingMethod method> i16 interpolate(Cycle clock);
+
+    // Removes all samples that are outdated at the specified cycle
+    void trim(Cycle clock);
 };
 
 }
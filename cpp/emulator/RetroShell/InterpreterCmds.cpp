@@ -522,7 +522,7 @@ Interpreter::initCommandShell(Command &root)
     root.add({"blitter", "set"},
              "Configures the component");
 
-    root.add({"blitter", "set", "accuracy"}, { "1..3" },
+    root.add({"blitter", "set", "accuracy"}, { "0..3" },
              "Selects the emulation accuracy level",
              [this](Arguments& argv, long value) {
 
@@ -624,6 +624,13 @@ Interpreter::initCommandShell(Command &root)
         amiga.configure(OPT_DMA_DEBUG_ENABLE, false);
     });
 
+    root.add({"dmadebugger", "stats"},
+             "Displays the bus usage of the previous frame",
+             [this](Arguments& argv, long value) {
+
+        retroShell.dump(amiga.agnus.dmaDebugger, Category::Stats);
+    });
+
     root.add({"dmadebugger", "copper"}, { Arg::onoff },
              "Turns Copper DMA visualization on or off",
              [this](Arguments& argv, long value) {
@@ -723,6 +730,48 @@ Interpreter::initCommandShell(Command &root)
         amiga.configure(OPT_SATURATION, parseNum(argv));
     });
 
+    root.add({"monitor", "set", "format"}, { TextureFormatEnum::argList() },
+             "Selects the pixel format of the compact texture",
+             [this](Arguments& argv, long value) {
+
+        amiga.configure(OPT_TEXTURE_FORMAT, parseEnum <TextureFormatEnum> (argv));
+    });
+
+    root.add({"monitor", "set", "resolution"}, { OutputResolutionEnum::argList() },
+             "Selects the resolution of the reduced texture",
+             [this](Arguments& argv, long value) {
+
+        amiga.configure(OPT_OUTPUT_RESOLUTION, parseEnum <OutputResolutionEnum> (argv));
+    });
+
+    root.add({"monitor", "set", "cropping"}, { Arg::boolean },
+             "Crops the texture to the tracked viewport",
+             [this](Arguments& argv, long value) {
+
+        amiga.configure(OPT_VIEWPORT_CROPPING, parseBool(argv));
+    });
+
+    root.add({"monitor", "set", "pipelining"}, { Arg::boolean },
+             "Colorizes rasterlines in a separate thread",
+             [this](Arguments& argv, long value) {
+
+        amiga.configure(OPT_PIPELINING, parseBool(argv));
+    });
+
+    root.add({"monitor", "set", "warpskip"}, { Arg::value },
+             "Only draws every n-th frame in warp mode",
+             [this](Arguments& argv, long value) {
+
+        amiga.configure(OPT_WARP_FRAME_SKIP, parseNum(argv));
+    });
+
+    root.add({"monitor", "set", "dirtyrows"}, { Arg::boolean },
+             "Reports the rows that have changed since the last frame",
+             [this](Arguments& argv, long value) {
+
+        amiga.configure(OPT_DIRTY_TRACKING, parseBool(argv));
+    });
+
     
     //
     // Paula (Audio)
@@ -825,6 +874,13 @@ Interpreter::initCommandShell(Command &root)
         amiga.configure(OPT_AUDVOLR, parseNum(argv));
     });
 
+    root.add({"paula", "audio", "set", "warpskip"}, { Arg::boolean },
+             "Suspends audio synthesis in warp mode",
+             [this](Arguments& argv, long value) {
+
+        amiga.configure(OPT_WARP_AUDIO_SKIP, parseBool(argv));
+    });
+
     root.add({"paula", "audio", "set", "pan"},
              "Sets the pan for one of the four audio channels");
     
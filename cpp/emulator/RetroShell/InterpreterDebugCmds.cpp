@@ -571,6 +571,39 @@ Interpreter::initDebugShell(Command &root)
         retroShell.dumpDebug(amiga.agnus.blitter);
     });
 
+    root.add({"blitter", "trace"},
+             "Records blits");
+
+    root.add({"blitter", "trace", "start"},
+             "Starts recording",
+             [this](Arguments& argv, long value) {
+
+        amiga.agnus.blitter.startTrace();
+    });
+
+    root.add({"blitter", "trace", "stop"},
+             "Stops recording",
+             [this](Arguments& argv, long value) {
+
+        amiga.agnus.blitter.stopTrace();
+    });
+
+    root.add({"blitter", "trace", "save"}, { Arg::path },
+             "Saves the recorded blits to a file",
+             [this](Arguments& argv, long value) {
+
+        amiga.agnus.blitter.saveTrace(argv.front());
+    });
+
+    root.add({"blitter", "trace", "replay"},
+             "Replays the recorded blits with the Fast and the Slow Blitter",
+             [this](Arguments& argv, long value) {
+
+        std::stringstream ss;
+        amiga.agnus.blitter.replayTrace(ss);
+        retroShell << ss;
+    });
+
 
     //
     // Copper
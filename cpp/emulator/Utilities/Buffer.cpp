@@ -211,6 +211,7 @@ template void Allocator<T>::patch(const u8 *seq, const u8 *subst); \
 template void Allocator<T>::patch(const char *seq, const char *subst);
 
 INSTANTIATE_ALLOCATOR(u8)
+INSTANTIATE_ALLOCATOR(u16)
 INSTANTIATE_ALLOCATOR(u32)
 INSTANTIATE_ALLOCATOR(u64)
 INSTANTIATE_ALLOCATOR(isize)
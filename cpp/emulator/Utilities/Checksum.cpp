@@ -55,6 +55,20 @@ fnv64(const u8 *addr, isize size)
     return hash;
 }
 
+u64
+fnv64(const u64 *addr, isize count)
+{
+    if (addr == nullptr || count == 0) return 0;
+
+    u64 hash = fnvInit64();
+
+    for (isize i = 0; i < count; i++) {
+        hash = fnvIt64(hash, addr[i]);
+    }
+
+    return hash;
+}
+
 u16 crc16(const u8 *addr, isize size)
 {
     u8 x;
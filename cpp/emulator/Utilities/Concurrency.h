@@ -12,6 +12,8 @@
 #include "Chrono.h"
 #include <thread>
 #include <future>
+#include <atomic>
+#include <memory>
 
 namespace util {
 
@@ -61,4 +63,87 @@ public:
     void wakeUp();
 };
 
+/* A bounded queue connecting a single producer thread with a single consumer
+ * thread. Elements are filled in place. The producer obtains a free slot with
+ * back() and publishes it with push(). The consumer obtains the oldest element
+ * with front() and releases it with pop(). Both sides block if the queue is
+ * full or empty, respectively. To keep the number of thread switches low, a
+ * sleeping consumer is woken up only after a batch of elements has arrived or
+ * if the producer waits for the queue to drain.
+ */
+template <class T, isize capacity> class SPSCQueue
+{
+    static constexpr isize batch = capacity / 4;
+
+    // Element storage (allocated on the heap as elements can be large)
+    std::unique_ptr<T[]> elements = std::make_unique<T[]>(capacity);
+
+    // Number of elements that have been pushed and popped
+    std::atomic<i64> pushed = 0;
+    std::atomic<i64> popped = 0;
+
+    // Indicates if the consumer or the producer is blocked
+    std::atomic<bool> consumerWaiting = false;
+    std::atomic<bool> producerWaiting = false;
+
+public:
+
+    // Producer side
+    T &back()
+    {
+        auto w = pushed.load(std::memory_order_relaxed);
+        waitForConsumer([&](i64 r) { return w - r < capacity; });
+        return elements[w % capacity];
+    }
+    void push()
+    {
+        auto w = pushed.fetch_add(1) + 1;
+        if (consumerWaiting.load() && w - popped.load() >= batch) wakeUpConsumer();
+    }
+
+    // Waits until the consumer has released all elements
+    void drain()
+    {
+        auto w = pushed.load(std::memory_order_relaxed);
+        waitForConsumer([&](i64 r) { return r == w; });
+    }
+
+    // Consumer side
+    T &front()
+    {
+        auto r = popped.load(std::memory_order_relaxed);
+        while (pushed.load() == r) {
+
+            consumerWaiting.store(true);
+            if (pushed.load() == r) consumerWaiting.wait(true);
+            consumerWaiting.store(false);
+        }
+        return elements[r % capacity];
+    }
+    void pop()
+    {
+        popped.fetch_add(1);
+        if (producerWaiting.load()) popped.notify_one();
+    }
+
+private:
+
+    void wakeUpConsumer()
+    {
+        consumerWaiting.store(false);
+        consumerWaiting.notify_one();
+    }
+
+    template <typename F> void waitForConsumer(F done)
+    {
+        auto r = popped.load();
+        if (done(r)) return;
+
+        producerWaiting.store(true);
+        wakeUpConsumer();
+        for (r = popped.load(); !done(r); r = popped.load()) popped.wait(r);
+        producerWaiting.store(false);
+    }
+};
+
 }
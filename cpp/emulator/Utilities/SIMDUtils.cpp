@@ -0,0 +1,74 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "SIMDUtils.h"
+#include <random>
+
+namespace util {
+
+void transposeScalar(const u16 *source, u8 *target, u8 rows)
+{
+    u16 mask = 0x8000;
+
+    for (isize i = 0; i < 16; i++, mask >>= 1) {
+
+        u8 column = 0;
+
+        for (isize j = 0; j < 8; j++) {
+            if ((rows & (1 << j)) && (source[j] & mask)) column |= u8(1 << j);
+        }
+        target[i] = column;
+    }
+}
+
+template <u8 rows> static bool
+compareTranspose(const u16 *source)
+{
+    u8 simd[16], scalar[16];
+
+    transpose<rows>(source, simd);
+    transposeScalar(source, scalar, rows);
+
+    return std::memcmp(simd, scalar, 16) == 0;
+}
+
+template <u8... rows> static bool
+compareTransposeAll(const u16 *source)
+{
+    return (compareTranspose<rows>(source) && ...);
+}
+
+bool
+checkTranspose(isize rounds)
+{
+    std::mt19937 rng(0);
+    u16 source[8];
+
+    for (isize i = 0; i < rounds; i++) {
+
+        for (auto &row : source) row = u16(rng());
+
+        bool success = compareTransposeAll <
+
+            // All planes for 1 to 6 bitplanes
+            0b000001, 0b000011, 0b000111, 0b001111, 0b011111, 0b111111,
+
+            // Odd and even planes for 1 to 6 bitplanes
+            0b000101, 0b010101, 0b000010, 0b001010, 0b101010,
+
+            // All rows
+            0xFF > (source);
+
+        if (!success) return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,123 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Types.h"
+#include "MemUtils.h"
+#include <array>
+
+namespace util {
+
+//
+// Vector types
+//
+
+/* The vector types are based on the vector extensions of GCC and Clang. The
+ * compiler maps them to the SIMD instruction set of the target architecture,
+ * i.e., to WebAssembly SIMD (-msimd128), SSE2, AVX2, or NEON. Operations the
+ * target doesn't support are broken down into scalar instructions. Hence,
+ * the same code runs on all platforms and no backend needs to be selected
+ * manually.
+ */
+typedef u8  u8x16 __attribute__((vector_size(16)));
+typedef u16 u16x8 __attribute__((vector_size(16)));
+typedef u32 u32x4 __attribute__((vector_size(16)));
+typedef u64 u64x2 __attribute__((vector_size(16)));
+
+// Reads a vector from an unaligned memory location
+template <class V> inline V load(const void *src)
+{
+    V result; std::memcpy(&result, src, sizeof(V)); return result;
+}
+
+// Writes a vector to an unaligned memory location
+template <class V> inline void store(void *dst, const V &value)
+{
+    std::memcpy(dst, &value, sizeof(V));
+}
+
+
+//
+// Planar to chunky conversion
+//
+
+/* Lookup table for spreading the bits of a byte over the bytes of a 64-bit
+ * word. The most significant bit ends up in the byte with the lowest memory
+ * address:
+ *
+ *     spread8[0b10000011] = 0x0101000000000001 (little endian)
+ */
+inline constexpr auto spread8 = []() {
+
+    std::array<u64, 256> result = { };
+
+    for (isize i = 0; i < 256; i++) {
+        for (isize j = 0; j < 8; j++) {
+            if (i & (0x80 >> j)) result[i] |= u64(1) << (8 * j);
+        }
+    }
+    if constexpr (std::endian::native == std::endian::big) {
+        for (auto &it : result) it = SWAP64(it);
+    }
+    return result;
+}();
+
+/* Transposes a 8 x 16 bit matrix.
+ *
+ *     Input:   A pointer to a u16[8] array.
+ *              Each array element stores a row of the matrix.
+ *     Output:  A pointer to a u8[16] array.
+ *              Array element at index i will contain the value on the i-column.
+ *              The least significant bit comes from the first row.
+ *
+ *     Rows:    A bit mask selecting the rows to consider. All other rows are
+ *              treated as zero.
+ *
+ *     Example: Input:  0xFF00, 0xF0F0, 0xCCCC, 0xAAAA, 0x8181
+ *
+ *                      0xFF00 -> 11111111 00000000
+ *                      0xF0F0 -> 11110000 11110000
+ *                      0xCCCC -> 11001100 11001100
+ *                      0xAAAA -> 10101010 10101010
+ *                      0x8181 -> 10000001 10000001
+ *
+ *                                        | Column values
+ *                                        v
+ *              Output: 31, 7, 11, 3, 13, 5, 9, 17, 30, 6, 10, 2, 12, 4, 8, 16
+ *
+ * The matrix is transposed eight columns at a time inside a 64-bit register.
+ * Each row contributes two table lookups, which are shifted into place.
+ */
+template <u8 rows = 0xFF> inline void transpose(const u16 *source, u8 *target)
+{
+    u64x2 columns = { 0, 0 };
+
+    for (isize i = 0; i < 8; i++) {
+
+        if (rows & (1 << i)) {
+
+            u64x2 bits = { spread8[source[i] >> 8], spread8[source[i] & 0xFF] };
+            columns |= bits << i;
+        }
+    }
+    store(target, columns);
+}
+
+// Reference implementation of transpose() processing one column at a time
+void transposeScalar(const u16 *source, u8 *target, u8 rows = 0xFF);
+
+/* Compares transpose() with transposeScalar() on random input. The check
+ * covers the row masks of all bitplane counts from 1 to 6, including the
+ * odd and even planes Denise extracts separately. Returns false if the two
+ * implementations disagree.
+ */
+bool checkTranspose(isize rounds = 1000);
+
+}
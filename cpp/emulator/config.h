@@ -113,6 +113,11 @@
 
 static const int NO_SEQ_FASTPATH = 0; // Disable sequencer fast path
 static const int NO_BPL_FASTPATH = 0; // Disable drawing fast path
+static const int NO_BPL_BATCHING = 0; // Disable line-batched bitplane DMA
+static const int NO_BLT_BATCHING = 0; // Disable batched fake Blitter cycles
+static const int NO_VEC_COLORIZE = 0; // Disable vectorized colorization
+static const int NO_FUSED_LINES  = 0; // Disable the fused line pipeline
+static const int NO_LINE_REUSE   = 0; // Disable reusing unchanged lines
 static const int DIAG_BOARD      = 0; // Plug in the diagnose board
 
 